@@ -1,7 +1,7 @@
 #include "lkjlib.h"
 
 // Data
-static const char* data_find(const char* str1, const char* str2, size_t size1, size_t size2) {
+static const char* data_find_scalar(const char* str1, const char* str2, size_t size1, size_t size2) {
     if (size1 < size2) {
         return NULL;
     }
@@ -13,6 +13,174 @@ static const char* data_find(const char* str1, const char* str2, size_t size1, s
     return NULL;
 }
 
+#if defined(__x86_64__)
+// Vector search compares a block of candidate starts against the needle's
+// first and last bytes at once and only runs memcmp on positions where both
+// match. Needles are at least two bytes here; the tail falls back to scalar.
+static const char* data_find_sse2(const char* str1, const char* str2, size_t size1, size_t size2) {
+    const __m128i first = _mm_set1_epi8(str2[0]);
+    const __m128i last = _mm_set1_epi8(str2[size2 - 1]);
+    size_t i = 0;
+    for (; i + size2 - 1 + 16 <= size1; i += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(str1 + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i*)(str1 + i + size2 - 1));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+        while (mask != 0) {
+            uint32_t bit = (uint32_t)__builtin_ctz(mask);
+            if (memcmp(str1 + i + bit + 1, str2 + 1, size2 - 2) == 0) {
+                return str1 + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return data_find_scalar(str1 + i, str2, size1 - i, size2);
+}
+
+__attribute__((target("avx2"))) static const char* data_find_avx2(const char* str1, const char* str2, size_t size1, size_t size2) {
+    const __m256i first = _mm256_set1_epi8(str2[0]);
+    const __m256i last = _mm256_set1_epi8(str2[size2 - 1]);
+    size_t i = 0;
+    for (; i + size2 - 1 + 32 <= size1; i += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(str1 + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i*)(str1 + i + size2 - 1));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+        while (mask != 0) {
+            uint32_t bit = (uint32_t)__builtin_ctz(mask);
+            if (memcmp(str1 + i + bit + 1, str2 + 1, size2 - 2) == 0) {
+                return str1 + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return data_find_scalar(str1 + i, str2, size1 - i, size2);
+}
+#endif
+
+static const char* data_find(const char* str1, const char* str2, size_t size1, size_t size2) {
+    if (size1 < size2) {
+        return NULL;
+    }
+    if (size2 == 1) {
+        return memchr(str1, *str2, size1);
+    }
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return data_find_avx2(str1, str2, size1, size2);
+    }
+    return data_find_sse2(str1, str2, size1, size2);
+#else
+    return data_find_scalar(str1, str2, size1, size2);
+#endif
+}
+
+// Byte-set scanning returns the first byte whose membership in set equals
+// match: match=1 finds the next delimiter, match=0 skips over a run of set
+// bytes such as whitespace. Sets longer than DATA_SET_MAXCOUNT use the
+// scalar loop.
+#define DATA_SET_MAXCOUNT 16
+
+static const char* data_scan_scalar(const char* p, const char* end, const char* set, size_t len, uint32_t match) {
+    while (p < end && (memchr(set, *p, len) != NULL) != match) {
+        p++;
+    }
+    return p;
+}
+
+#if defined(__x86_64__)
+static const char* data_scan_sse2(const char* p, const char* end, const char* set, size_t len, uint32_t match) {
+    __m128i needles[DATA_SET_MAXCOUNT];
+    for (size_t i = 0; i < len; i++) {
+        needles[i] = _mm_set1_epi8(set[i]);
+    }
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_setzero_si128();
+        for (size_t i = 0; i < len; i++) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, needles[i]));
+        }
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+        if (!match) {
+            mask ^= 0xffff;
+        }
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return data_scan_scalar(p, end, set, len, match);
+}
+
+__attribute__((target("avx2"))) static const char* data_scan_avx2(const char* p, const char* end, const char* set, size_t len, uint32_t match) {
+    __m256i needles[DATA_SET_MAXCOUNT];
+    for (size_t i = 0; i < len; i++) {
+        needles[i] = _mm256_set1_epi8(set[i]);
+    }
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hit = _mm256_setzero_si256();
+        for (size_t i = 0; i < len; i++) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+        if (!match) {
+            mask = ~mask;
+        }
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return data_scan_scalar(p, end, set, len, match);
+}
+#endif
+
+static const char* data_scan(const char* p, const char* end, const char* set, uint32_t match) {
+    size_t len = strlen(set);
+    // Most delimiters and whitespace runs are short, so settle the first
+    // byte before paying for vector setup.
+    if (p >= end || (memchr(set, *p, len) != NULL) == match) {
+        return p;
+    }
+    if (match && len == 1) {
+        const char* pos = memchr(p, *set, (size_t)(end - p));
+        return pos != NULL ? pos : end;
+    }
+    if (len > DATA_SET_MAXCOUNT) {
+        return data_scan_scalar(p, end, set, len, match);
+    }
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return data_scan_avx2(p, end, set, len, match);
+    }
+    return data_scan_sse2(p, end, set, len, match);
+#else
+    return data_scan_scalar(p, end, set, len, match);
+#endif
+}
+
+// Interned data is shared through the pool's intern table, so mutators that
+// overwrite or truncate take a private copy first. In-place appends check
+// hash alongside capacity and go through data_grow, whose realloc copies.
+static result_t data_make_private(pool_t* pool, data_t** data, uint64_t capacity) {
+    if ((*data)->hash == 0) {
+        return RESULT_OK;
+    }
+    if (pool_data_realloc(pool, data, capacity > (*data)->size ? capacity : (*data)->size) != RESULT_OK) {
+        RETURN_ERR("Failed to copy interned data");
+    }
+    return RESULT_OK;
+}
+
+// Appends grow capacity geometrically so byte-at-a-time builders settle
+// into amortized O(1) appends instead of stepping through every class.
+static result_t data_grow(pool_t* pool, data_t** data, uint64_t capacity) {
+    uint64_t doubled = (*data)->capacity * 2;
+    if (pool_data_realloc(pool, data, capacity > doubled ? capacity : doubled) != RESULT_OK) {
+        RETURN_ERR("Failed to grow data capacity");
+    }
+    return RESULT_OK;
+}
+
 result_t data_create(pool_t* pool, data_t** data) {
     if (pool_data_alloc(pool, data, 16) != RESULT_OK) {
         RETURN_ERR("Failed to allocate data with capacity 16");
@@ -40,20 +208,59 @@ result_t data_create_str(pool_t* pool, data_t** data, const char* str) {
     return RESULT_OK;
 }
 
+// Interned data is shared through the pool's intern table and must be
+// treated as read-only; destroying it is a no-op.
+result_t data_intern_data(pool_t* pool, data_t** data1, const data_t* data2) {
+    data_view_t view = data_view_data(data2);
+    if (pool_intern(pool, data1, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to intern data");
+    }
+    return RESULT_OK;
+}
+
+result_t data_intern_str(pool_t* pool, data_t** data, const char* str) {
+    data_view_t view = data_view_str(str);
+    if (pool_intern(pool, data, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to intern string");
+    }
+    return RESULT_OK;
+}
+
+result_t data_intern_view(pool_t* pool, data_t** data, const data_view_t* view) {
+    if (pool_intern(pool, data, view) != RESULT_OK) {
+        RETURN_ERR("Failed to intern view");
+    }
+    return RESULT_OK;
+}
+
 result_t data_clean(pool_t* pool, data_t** data) {
+    if (data_make_private(pool, data, 16) != RESULT_OK) {
+        RETURN_ERR("Failed to make data private to clean it");
+    }
+    (*data)->size = 0;
     if (pool_data_realloc(pool, data, 16) != RESULT_OK) {
         RETURN_ERR("Failed to reallocate data to clean it");
     }
-    (*data)->size = 0;
     return RESULT_OK;
 }
 
-result_t data_copy_data(pool_t* pool, data_t** data1, const data_t* data2) {
-    if ((*data1)->capacity != data2->capacity) {
-        if (pool_data_realloc(pool, data1, data2->capacity) != RESULT_OK) {
-            RETURN_ERR("Failed to reallocate data with sufficient capacity");
+result_t data_reserve(pool_t* pool, data_t** data, uint64_t size) {
+    if ((*data)->hash != 0 || (*data)->size + size > (*data)->capacity) {
+        if (pool_data_realloc(pool, data, (*data)->size + size) != RESULT_OK) {
+            RETURN_ERR("Failed to reserve data capacity");
         }
     }
+    return RESULT_OK;
+}
+
+result_t data_copy_data(pool_t* pool, data_t** data1, const data_t* data2) {
+    if (data_make_private(pool, data1, data2->size) != RESULT_OK) {
+        RETURN_ERR("Failed to make data private before copying");
+    }
+    (*data1)->size = 0;
+    if (pool_data_realloc(pool, data1, data2->size) != RESULT_OK) {
+        RETURN_ERR("Failed to reallocate data with sufficient capacity");
+    }
     (*data1)->size = data2->size;
     memcpy((*data1)->data, data2->data, data2->size);
     return RESULT_OK;
@@ -61,6 +268,10 @@ result_t data_copy_data(pool_t* pool, data_t** data1, const data_t* data2) {
 
 result_t data_copy_str(pool_t* pool, data_t** data, const char* str) {
     size_t len = strlen(str);
+    if (data_make_private(pool, data, len) != RESULT_OK) {
+        RETURN_ERR("Failed to make data private before copying");
+    }
+    (*data)->size = 0;
     if (pool_data_realloc(pool, data, len) != RESULT_OK) {
         RETURN_ERR("Failed to reallocate data with sufficient capacity");
     }
@@ -70,404 +281,1716 @@ result_t data_copy_str(pool_t* pool, data_t** data, const char* str) {
 }
 
 result_t data_append_data(pool_t* pool, data_t** data1, const data_t* data2) {
-    if ((*data1)->size + data2->size > (*data1)->capacity) {
-        data_t* data_old = *data1;
-        data_t* data_new = NULL;
-        if (pool_data_alloc(pool, &data_new, data_old->size + data2->size) != RESULT_OK) {
-            RETURN_ERR("Failed to allocate data with sufficient capacity");
-        }
-        memcpy(data_new->data, data_old->data, data_old->size);
-        memcpy(data_new->data + data_old->size, data2->data, data2->size);
-        data_new->size = data_old->size + data2->size;
-        *data1 = data_new;
-        if (pool_data_free(pool, data_old) != RESULT_OK) {
-            RETURN_ERR("Failed to free old data");
+    if ((*data1)->hash != 0 || (*data1)->size + data2->size > (*data1)->capacity) {
+        if (data_grow(pool, data1, (*data1)->size + data2->size) != RESULT_OK) {
+            RETURN_ERR("Failed to reallocate data with sufficient capacity");
         }
-    } else {
-        memcpy((*data1)->data + (*data1)->size, data2->data, data2->size);
-        (*data1)->size += data2->size;
     }
+    memcpy((*data1)->data + (*data1)->size, data2->data, data2->size);
+    (*data1)->size += data2->size;
     return RESULT_OK;
 }
 
 result_t data_append_str(pool_t* pool, data_t** data, const char* str) {
     size_t str_len = strlen(str);
-    if ((*data)->size + str_len > (*data)->capacity) {
-        data_t* data_old = *data;
-        data_t* data_new = NULL;
-        if (pool_data_alloc(pool, &data_new, (*data)->size + str_len) != RESULT_OK) {
-            RETURN_ERR("Failed to allocate data with sufficient capacity");
-        }
-        memcpy(data_new->data, data_old->data, data_old->size);
-        memcpy(data_new->data + data_old->size, str, str_len);
-        data_new->size = data_old->size + str_len;
-        *data = data_new;
-        if (pool_data_free(pool, data_old) != RESULT_OK) {
-            RETURN_ERR("Failed to free old data");
+    if ((*data)->hash != 0 || (*data)->size + str_len > (*data)->capacity) {
+        if (data_grow(pool, data, (*data)->size + str_len) != RESULT_OK) {
+            RETURN_ERR("Failed to reallocate data with sufficient capacity");
         }
-    } else {
-        memcpy((*data)->data + (*data)->size, str, str_len);
-        (*data)->size += str_len;
     }
+    memcpy((*data)->data + (*data)->size, str, str_len);
+    (*data)->size += str_len;
     return RESULT_OK;
 }
 
 result_t data_append_char(pool_t* pool, data_t** data, char c) {
-    if ((*data)->size + 1 >= (*data)->capacity) {
-        data_t* data_old = *data;
-        data_t* data_new = NULL;
-        if (pool_data_alloc(pool, &data_new, (*data)->size + 1) != RESULT_OK) {
-            RETURN_ERR("Failed to allocate data with sufficient capacity");
-        }
-        memcpy(data_new->data, data_old->data, data_old->size);
-        data_new->data[data_old->size] = c;
-        data_new->size = data_old->size + 1;
-        *data = data_new;
-        if (pool_data_free(pool, data_old) != RESULT_OK) {
-            RETURN_ERR("Failed to free old data");
+    if ((*data)->hash != 0 || (*data)->size + 1 >= (*data)->capacity) {
+        if (data_grow(pool, data, (*data)->size + 1) != RESULT_OK) {
+            RETURN_ERR("Failed to reallocate data with sufficient capacity");
         }
-    } else {
-        (*data)->data[(*data)->size++] = c;
     }
+    (*data)->data[(*data)->size++] = c;
     return RESULT_OK;
 }
 
 result_t data_toint(const data_t* data, int64_t* dst) {
-    int64_t value = 0;
-    int neg;
-    uint64_t i;
-    uint64_t size = data->size;
-    if (data->data[0] == '-') {
-        neg = 1;
-        i = 1;
-    } else {
-        neg = 0;
-        i = 0;
+    data_view_t view = data_view_data(data);
+    if (data_view_toint(&view, dst) != RESULT_OK) {
+        RETURN_ERR("Failed to convert data to integer");
     }
-    while(i < size) {
-        char c = data->data[i];
-        if(c < '0' || c > '9') {
-            RETURN_ERR("Invalid character in data");
-        }
-        value = value * 10 + (c - '0');
-        i++;
-    }
-    if (neg) {
-        value = -value;
+    return RESULT_OK;
+}
+
+result_t data_todouble(const data_t* data, double* dst) {
+    data_view_t view = data_view_data(data);
+    if (data_view_todouble(&view, dst) != RESULT_OK) {
+        RETURN_ERR("Failed to convert data to double");
     }
-    *dst = value;
     return RESULT_OK;
 }
 
 uint64_t data_equal_data(const data_t* data1, const data_t* data2) {
-    if (data1->size != data2->size) {
+    if (data1 == data2) {
+        return 1;
+    }
+    if (data1->hash != 0 && data2->hash != 0 && data1->hash != data2->hash) {
         return 0;
     }
-    return memcmp(data1->data, data2->data, data1->size) == 0;
+    data_view_t view1 = data_view_data(data1);
+    data_view_t view2 = data_view_data(data2);
+    return data_view_equal_view(&view1, &view2);
 }
 
 uint64_t data_equal_str(const data_t* data, const char* str) {
-    size_t len = strlen(str);
-    if (data->size != len) {
-        return 0;
-    }
-    return memcmp(data->data, str, len) == 0;
+    data_view_t view = data_view_data(data);
+    return data_view_equal_str(&view, str);
 }
 
 int64_t data_find_data(const data_t* data1, const data_t* data2, uint64_t index) {
-    if (index >= data1->size || data2->size == 0) {
-        return -1;
-    }
-    const char* pos = data_find(data1->data + index, data2->data, data1->size - index, data2->size);
-    if (!pos) {
-        return -1;
-    }
-    return pos - data1->data;
+    data_view_t view1 = data_view_data(data1);
+    data_view_t view2 = data_view_data(data2);
+    return data_view_find_view(&view1, &view2, index);
 }
 
 int64_t data_find_str(const data_t* data, const char* str, uint64_t index) {
-    if (index >= data->size || !str || *str == '\0') {
-        return -1;
-    }
-    const char* pos = data_find(data->data + index, str, data->size - index, strlen(str));
-    if (!pos) {
-        return -1;
-    }
-    return pos - data->data;
+    data_view_t view = data_view_data(data);
+    return data_view_find_str(&view, str, index);
 }
 
 int64_t data_find_char(const data_t* data, char c, uint64_t index) {
-    if (index >= data->size) {
+    data_view_t view = data_view_data(data);
+    return data_view_find_char(&view, c, index);
+}
+
+int64_t data_find_any(const data_t* data, const char* set, uint64_t index) {
+    if (index >= data->size || !set || *set == '\0') {
         return -1;
     }
-    const char* pos = data_find(data->data + index, &c, data->size - index, 1);
-    if (!pos) {
+    const char* end = data->data + data->size;
+    const char* pos = data_scan(data->data + index, end, set, 1);
+    if (pos == end) {
         return -1;
     }
     return pos - data->data;
 }
 
-result_t data_escape_json(pool_t* pool, data_t** data) {
-    data_t* result = NULL;
-    if (data_create(pool, &result) != RESULT_OK) {
-        RETURN_ERR("Failed to create result data");
+const char* data_scan_any(const char* p, const char* end, const char* set) {
+    return data_scan(p, end, set, 1);
+}
+
+const char* data_skip_any(const char* p, const char* end, const char* set) {
+    return data_scan(p, end, set, 0);
+}
+
+// Data UTF-8
+// Validation follows the Unicode well-formed byte sequence table: no
+// overlongs, no surrogates, nothing above U+10FFFF. The AVX2 path is the
+// Keiser-Lemire lookup method: three nibble lookups per byte pair classify
+// every two-byte error at once, and a shifted compare checks that third and
+// fourth bytes are continuations exactly where a lead byte demands them.
+// Code points are counted as bytes that are not continuation bytes.
+static const char* data_utf8_next(const char* p, const char* end) {
+    const unsigned char* s = (const unsigned char*)p;
+    uint64_t n = (uint64_t)(end - p);
+    if (s[0] < 0x80) {
+        return p + 1;
     }
-    
-    for (uint64_t i = 0; i < (*data)->size; i++) {
-        char c = (*data)->data[i];
-        switch (c) {
-            case '"':
-                if (data_append_str(pool, &result, "\\\"") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped quote");
-                }
-                break;
-            case '\\':
-                if (data_append_str(pool, &result, "\\\\") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped backslash");
-                }
-                break;
-            case '\b':
-                if (data_append_str(pool, &result, "\\b") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped backspace");
-                }
-                break;
-            case '\f':
-                if (data_append_str(pool, &result, "\\f") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped form feed");
-                }
-                break;
-            case '\n':
-                if (data_append_str(pool, &result, "\\n") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped newline");
-                }
-                break;
-            case '\r':
-                if (data_append_str(pool, &result, "\\r") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped carriage return");
-                }
-                break;
-            case '\t':
-                if (data_append_str(pool, &result, "\\t") != RESULT_OK) {
-                    if (data_destroy(pool, result) != RESULT_OK) {
-                        PRINT_ERR("Failed to destroy result data during cleanup");
-                    }
-                    RETURN_ERR("Failed to append escaped tab");
-                }
-                break;
-            default:
-                if ((unsigned char)c < 0x20) {
-                    // Escape control characters as \uXXXX
-                    char hex_buffer[7];
-                    snprintf(hex_buffer, sizeof(hex_buffer), "\\u%04x", (unsigned char)c);
-                    if (data_append_str(pool, &result, hex_buffer) != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unicode escape");
-                    }
-                } else {
-                    if (data_append_char(pool, &result, c) != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append regular character");
-                    }
-                }
-                break;
+    if (s[0] >= 0xC2 && s[0] <= 0xDF) {
+        return n >= 2 && (s[1] & 0xC0) == 0x80 ? p + 2 : NULL;
+    }
+    if (s[0] >= 0xE0 && s[0] <= 0xEF) {
+        if (n < 3 || (s[2] & 0xC0) != 0x80) {
+            return NULL;
         }
+        unsigned char lo = s[0] == 0xE0 ? 0xA0 : 0x80;
+        unsigned char hi = s[0] == 0xED ? 0x9F : 0xBF;
+        return s[1] >= lo && s[1] <= hi ? p + 3 : NULL;
     }
-    
-    data_t* old_data = *data;
-    *data = result;
-    if (data_destroy(pool, old_data) != RESULT_OK) {
-        RETURN_ERR("Failed to destroy old data");
+    if (s[0] >= 0xF0 && s[0] <= 0xF4) {
+        if (n < 4 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80) {
+            return NULL;
+        }
+        unsigned char lo = s[0] == 0xF0 ? 0x90 : 0x80;
+        unsigned char hi = s[0] == 0xF4 ? 0x8F : 0xBF;
+        return s[1] >= lo && s[1] <= hi ? p + 4 : NULL;
     }
-    
-    return RESULT_OK;
+    return NULL;
 }
 
-static int hex_char_to_int(char c) {
-    if (c >= '0' && c <= '9') return c - '0';
-    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
-    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-    return -1;
+#if !defined(__x86_64__)
+static uint64_t data_utf8_valid_scalar(const char* p, const char* end) {
+    while (p < end) {
+        p = data_utf8_next(p, end);
+        if (p == NULL) {
+            return 0;
+        }
+    }
+    return 1;
 }
+#endif
 
-result_t data_unescape_json(pool_t* pool, data_t** data) {
-    data_t* result = NULL;
-    if (data_create(pool, &result) != RESULT_OK) {
-        RETURN_ERR("Failed to create result data");
+static uint64_t data_utf8_count_scalar(const char* p, const char* end) {
+    uint64_t count = 0;
+    for (; p < end; p++) {
+        count += ((unsigned char)*p & 0xC0) != 0x80;
     }
-    
-    for (uint64_t i = 0; i < (*data)->size; i++) {
-        char c = (*data)->data[i];
-        if (c == '\\' && i + 1 < (*data)->size) {
-            char next = (*data)->data[i + 1];
-            switch (next) {
-                case '"':
-                    if (data_append_char(pool, &result, '"') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped quote");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case '\\':
-                    if (data_append_char(pool, &result, '\\') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped backslash");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case '/':
-                    if (data_append_char(pool, &result, '/') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped slash");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 'b':
-                    if (data_append_char(pool, &result, '\b') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped backspace");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 'f':
-                    if (data_append_char(pool, &result, '\f') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped form feed");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 'n':
-                    if (data_append_char(pool, &result, '\n') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped newline");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 'r':
-                    if (data_append_char(pool, &result, '\r') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped carriage return");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 't':
-                    if (data_append_char(pool, &result, '\t') != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append unescaped tab");
-                    }
-                    i++; // Skip the next character
-                    break;
-                case 'u':
-                    // Unicode escape sequence \uXXXX
-                    if (i + 5 < (*data)->size) {
-                        int hex1 = hex_char_to_int((*data)->data[i + 2]);
-                        int hex2 = hex_char_to_int((*data)->data[i + 3]);
-                        int hex3 = hex_char_to_int((*data)->data[i + 4]);
-                        int hex4 = hex_char_to_int((*data)->data[i + 5]);
-                        
-                        if (hex1 >= 0 && hex2 >= 0 && hex3 >= 0 && hex4 >= 0) {
-                            int unicode_value = (hex1 << 12) | (hex2 << 8) | (hex3 << 4) | hex4;
-                            if (unicode_value < 0x80) {
-                                // ASCII character
-                                if (data_append_char(pool, &result, (char)unicode_value) != RESULT_OK) {
-                                    if (data_destroy(pool, result) != RESULT_OK) {
-                                        PRINT_ERR("Failed to destroy result data during cleanup");
-                                    }
-                                    RETURN_ERR("Failed to append unicode character");
-                                }
-                            } else {
-                                // For simplicity, we'll handle only ASCII range characters
-                                // In a full implementation, you'd need proper UTF-8 encoding
-                                if (data_append_char(pool, &result, '?') != RESULT_OK) {
-                                    if (data_destroy(pool, result) != RESULT_OK) {
-                                        PRINT_ERR("Failed to destroy result data during cleanup");
-                                    }
-                                    RETURN_ERR("Failed to append replacement character");
-                                }
-                            }
-                            i += 5; // Skip the entire \uXXXX sequence
-                        } else {
-                            // Invalid unicode escape, treat as literal
-                            if (data_append_char(pool, &result, c) != RESULT_OK) {
-                                if (data_destroy(pool, result) != RESULT_OK) {
-                                    PRINT_ERR("Failed to destroy result data during cleanup");
-                                }
-                                RETURN_ERR("Failed to append literal backslash");
-                            }
-                        }
-                    } else {
-                        // Incomplete unicode escape, treat as literal
-                        if (data_append_char(pool, &result, c) != RESULT_OK) {
-                            if (data_destroy(pool, result) != RESULT_OK) {
-                                PRINT_ERR("Failed to destroy result data during cleanup");
-                            }
-                            RETURN_ERR("Failed to append literal backslash");
-                        }
-                    }
-                    break;
-                default:
-                    // Unknown escape sequence, treat as literal
-                    if (data_append_char(pool, &result, c) != RESULT_OK) {
-                        if (data_destroy(pool, result) != RESULT_OK) {
-                            PRINT_ERR("Failed to destroy result data during cleanup");
-                        }
-                        RETURN_ERR("Failed to append literal backslash");
-                    }
-                    break;
-            }
+    return count;
+}
+
+#if defined(__x86_64__)
+static uint64_t data_utf8_valid_sse2(const char* p, const char* end) {
+    while (p < end) {
+        if (end - p >= 16 && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p)) == 0) {
+            p += 16;
+            continue;
+        }
+        p = data_utf8_next(p, end);
+        if (p == NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint64_t data_utf8_count_sse2(const char* p, const char* end) {
+    uint64_t count = 0;
+    __m128i cont = _mm_set1_epi8((char)0xBF);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        count += (uint64_t)__builtin_popcount((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(block, cont)));
+        p += 16;
+    }
+    return count + data_utf8_count_scalar(p, end);
+}
+
+#define DATA_UTF8_TOO_SHORT (1 << 0)
+#define DATA_UTF8_TOO_LONG (1 << 1)
+#define DATA_UTF8_OVERLONG_3 (1 << 2)
+#define DATA_UTF8_TOO_LARGE (1 << 3)
+#define DATA_UTF8_SURROGATE (1 << 4)
+#define DATA_UTF8_OVERLONG_2 (1 << 5)
+#define DATA_UTF8_TOO_LARGE_1000 (1 << 6)
+#define DATA_UTF8_OVERLONG_4 (1 << 6)
+#define DATA_UTF8_TWO_CONTS (1 << 7)
+#define DATA_UTF8_CARRY (DATA_UTF8_TOO_SHORT | DATA_UTF8_TOO_LONG | DATA_UTF8_TWO_CONTS)
+
+__attribute__((target("avx2"))) static __m256i data_utf8_block_avx2(__m256i input, __m256i prev_input) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG,
+        DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG,
+        DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_OVERLONG_2,
+        DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_OVERLONG_3 | DATA_UTF8_SURROGATE,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_OVERLONG_4,
+        DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG,
+        DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG, DATA_UTF8_TOO_LONG,
+        DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS, DATA_UTF8_TWO_CONTS,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_OVERLONG_2,
+        DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_OVERLONG_3 | DATA_UTF8_SURROGATE,
+        DATA_UTF8_TOO_SHORT | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_OVERLONG_4);
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        DATA_UTF8_CARRY | DATA_UTF8_OVERLONG_3 | DATA_UTF8_OVERLONG_2 | DATA_UTF8_OVERLONG_4,
+        DATA_UTF8_CARRY | DATA_UTF8_OVERLONG_2,
+        DATA_UTF8_CARRY,
+        DATA_UTF8_CARRY,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_SURROGATE,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_OVERLONG_3 | DATA_UTF8_OVERLONG_2 | DATA_UTF8_OVERLONG_4,
+        DATA_UTF8_CARRY | DATA_UTF8_OVERLONG_2,
+        DATA_UTF8_CARRY,
+        DATA_UTF8_CARRY,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_SURROGATE,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000,
+        DATA_UTF8_CARRY | DATA_UTF8_TOO_LARGE | DATA_UTF8_TOO_LARGE_1000);
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_OVERLONG_3 | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_OVERLONG_4,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_OVERLONG_3 | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_SURROGATE | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_SURROGATE | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_OVERLONG_3 | DATA_UTF8_TOO_LARGE_1000 | DATA_UTF8_OVERLONG_4,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_OVERLONG_3 | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_SURROGATE | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_LONG | DATA_UTF8_OVERLONG_2 | DATA_UTF8_TWO_CONTS | DATA_UTF8_SURROGATE | DATA_UTF8_TOO_LARGE,
+        DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT, DATA_UTF8_TOO_SHORT);
+    // The bytes one, two and three positions back, carried across blocks
+    __m256i carried = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+    __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must_continue, special);
+}
+
+__attribute__((target("avx2"))) static uint64_t data_utf8_valid_avx2(const char* p, const char* end) {
+    // A block ending inside a sequence leaves bytes above these limits
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    while (end - p >= 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i*)p);
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
         } else {
-            if (data_append_char(pool, &result, c) != RESULT_OK) {
-                if (data_destroy(pool, result) != RESULT_OK) {
-                    PRINT_ERR("Failed to destroy result data during cleanup");
-                }
-                RETURN_ERR("Failed to append regular character");
-            }
+            error = _mm256_or_si256(error, data_utf8_block_avx2(input, prev_input));
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+            prev_input = input;
         }
+        p += 32;
     }
-    
-    data_t* old_data = *data;
-    *data = result;
-    if (data_destroy(pool, old_data) != RESULT_OK) {
-        RETURN_ERR("Failed to destroy old data");
+    // The zero padding of the last block also flags a sequence cut off by
+    // the end of the input
+    char tail[32] = {0};
+    memcpy(tail, p, (size_t)(end - p));
+    __m256i input = _mm256_loadu_si256((const __m256i*)tail);
+    error = _mm256_or_si256(error, data_utf8_block_avx2(input, prev_input));
+    return _mm256_testz_si256(error, error);
+}
+
+__attribute__((target("avx2"))) static uint64_t data_utf8_count_avx2(const char* p, const char* end) {
+    uint64_t count = 0;
+    __m256i cont = _mm256_set1_epi8((char)0xBF);
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)p);
+        count += (uint64_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, cont)));
+        p += 32;
+    }
+    return count + data_utf8_count_scalar(p, end);
+}
+#endif
+
+uint64_t data_view_utf8_valid(const data_view_t* view) {
+    const char* p = view->data;
+    const char* end = p + view->size;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return data_utf8_valid_avx2(p, end);
+    }
+    return data_utf8_valid_sse2(p, end);
+#else
+    return data_utf8_valid_scalar(p, end);
+#endif
+}
+
+uint64_t data_view_utf8_count(const data_view_t* view) {
+    const char* p = view->data;
+    const char* end = p + view->size;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return data_utf8_count_avx2(p, end);
+    }
+    return data_utf8_count_sse2(p, end);
+#else
+    return data_utf8_count_scalar(p, end);
+#endif
+}
+
+uint64_t data_utf8_valid(const data_t* data) {
+    data_view_t view = data_view_data(data);
+    return data_view_utf8_valid(&view);
+}
+
+uint64_t data_utf8_count(const data_t* data) {
+    data_view_t view = data_view_data(data);
+    return data_view_utf8_count(&view);
+}
+
+// Data number
+// Integers are written two digits at a time from a pair table. Doubles use
+// Grisu2: the value and its rounding boundaries are scaled by a cached power
+// of ten into 64-bit fixed point and digits are generated until they fall
+// inside the boundaries, which yields the shortest (or very nearly shortest)
+// string that parses back to the same double. Output follows the JavaScript
+// layout: plain digits for exponents up to 21, otherwise d.ddde[-]x.
+static const char data_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static uint64_t data_format_uint(char* out, uint64_t value) {
+    char buf[20];
+    char* p = buf + sizeof(buf);
+    while (value >= 100) {
+        uint64_t pair = (value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        memcpy(p, data_digit_pairs + pair, 2);
+    }
+    if (value >= 10) {
+        p -= 2;
+        memcpy(p, data_digit_pairs + value * 2, 2);
+    } else {
+        *--p = (char)('0' + value);
+    }
+    uint64_t len = (uint64_t)(buf + sizeof(buf) - p);
+    memcpy(out, p, len);
+    return len;
+}
+
+static uint64_t data_format_int(char* out, int64_t value) {
+    if (value < 0) {
+        out[0] = '-';
+        return 1 + data_format_uint(out + 1, (uint64_t)0 - (uint64_t)value);
+    }
+    return data_format_uint(out, (uint64_t)value);
+}
+
+typedef struct data_diyfp_t {
+    uint64_t f;
+    int32_t e;
+} data_diyfp_t;
+
+// Normalized 64-bit significands of 10^k for k = -348, -340, ..., 340.
+static const data_diyfp_t data_cached_powers[87] = {
+    {0xfa8fd5a0081c0288ull, -1220}, {0xbaaee17fa23ebf76ull, -1193}, {0x8b16fb203055ac76ull, -1166}, {0xcf42894a5dce35eaull, -1140},
+    {0x9a6bb0aa55653b2dull, -1113}, {0xe61acf033d1a45dfull, -1087}, {0xab70fe17c79ac6caull, -1060}, {0xff77b1fcbebcdc4full, -1034},
+    {0xbe5691ef416bd60cull, -1007}, {0x8dd01fad907ffc3cull, -980}, {0xd3515c2831559a83ull, -954}, {0x9d71ac8fada6c9b5ull, -927},
+    {0xea9c227723ee8bcbull, -901}, {0xaecc49914078536dull, -874}, {0x823c12795db6ce57ull, -847}, {0xc21094364dfb5637ull, -821},
+    {0x9096ea6f3848984full, -794}, {0xd77485cb25823ac7ull, -768}, {0xa086cfcd97bf97f4ull, -741}, {0xef340a98172aace5ull, -715},
+    {0xb23867fb2a35b28eull, -688}, {0x84c8d4dfd2c63f3bull, -661}, {0xc5dd44271ad3cdbaull, -635}, {0x936b9fcebb25c996ull, -608},
+    {0xdbac6c247d62a584ull, -582}, {0xa3ab66580d5fdaf6ull, -555}, {0xf3e2f893dec3f126ull, -529}, {0xb5b5ada8aaff80b8ull, -502},
+    {0x87625f056c7c4a8bull, -475}, {0xc9bcff6034c13053ull, -449}, {0x964e858c91ba2655ull, -422}, {0xdff9772470297ebdull, -396},
+    {0xa6dfbd9fb8e5b88full, -369}, {0xf8a95fcf88747d94ull, -343}, {0xb94470938fa89bcfull, -316}, {0x8a08f0f8bf0f156bull, -289},
+    {0xcdb02555653131b6ull, -263}, {0x993fe2c6d07b7facull, -236}, {0xe45c10c42a2b3b06ull, -210}, {0xaa242499697392d3ull, -183},
+    {0xfd87b5f28300ca0eull, -157}, {0xbce5086492111aebull, -130}, {0x8cbccc096f5088ccull, -103}, {0xd1b71758e219652cull, -77},
+    {0x9c40000000000000ull, -50}, {0xe8d4a51000000000ull, -24}, {0xad78ebc5ac620000ull, 3}, {0x813f3978f8940984ull, 30},
+    {0xc097ce7bc90715b3ull, 56}, {0x8f7e32ce7bea5c70ull, 83}, {0xd5d238a4abe98068ull, 109}, {0x9f4f2726179a2245ull, 136},
+    {0xed63a231d4c4fb27ull, 162}, {0xb0de65388cc8ada8ull, 189}, {0x83c7088e1aab65dbull, 216}, {0xc45d1df942711d9aull, 242},
+    {0x924d692ca61be758ull, 269}, {0xda01ee641a708deaull, 295}, {0xa26da3999aef774aull, 322}, {0xf209787bb47d6b85ull, 348},
+    {0xb454e4a179dd1877ull, 375}, {0x865b86925b9bc5c2ull, 402}, {0xc83553c5c8965d3dull, 428}, {0x952ab45cfa97a0b3ull, 455},
+    {0xde469fbd99a05fe3ull, 481}, {0xa59bc234db398c25ull, 508}, {0xf6c69a72a3989f5cull, 534}, {0xb7dcbf5354e9beceull, 561},
+    {0x88fcf317f22241e2ull, 588}, {0xcc20ce9bd35c78a5ull, 614}, {0x98165af37b2153dfull, 641}, {0xe2a0b5dc971f303aull, 667},
+    {0xa8d9d1535ce3b396ull, 694}, {0xfb9b7cd9a4a7443cull, 720}, {0xbb764c4ca7a44410ull, 747}, {0x8bab8eefb6409c1aull, 774},
+    {0xd01fef10a657842cull, 800}, {0x9b10a4e5e9913129ull, 827}, {0xe7109bfba19c0c9dull, 853}, {0xac2820d9623bf429ull, 880},
+    {0x80444b5e7aa7cf85ull, 907}, {0xbf21e44003acdd2dull, 933}, {0x8e679c2f5e44ff8full, 960}, {0xd433179d9c8cb841ull, 986},
+    {0x9e19db92b4e31ba9ull, 1013}, {0xeb96bf6ebadf77d9ull, 1039}, {0xaf87023b9bf0ee6bull, 1066},};
+
+static const uint32_t data_pow10_u32[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+static data_diyfp_t data_diyfp_mul(data_diyfp_t a, data_diyfp_t b) {
+    __uint128_t p = (__uint128_t)a.f * b.f;
+    uint64_t h = (uint64_t)(p >> 64);
+    uint64_t l = (uint64_t)p;
+    data_diyfp_t r = {h + (l >> 63), a.e + b.e + 64};
+    return r;
+}
+
+static data_diyfp_t data_diyfp_normalize(data_diyfp_t v) {
+    int shift = __builtin_clzll(v.f);
+    v.f <<= shift;
+    v.e -= shift;
+    return v;
+}
+
+static void data_grisu_round(char* buf, uint64_t len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+// Writes the digits of a positive finite double to buf and returns their
+// count; the value is digits * 10^*k.
+static uint64_t data_grisu2(double value, char* buf, int32_t* k) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t significand = bits & 0x000FFFFFFFFFFFFFull;
+    int32_t biased = (int32_t)((bits >> 52) & 0x7FF);
+    data_diyfp_t v;
+    if (biased != 0) {
+        v.f = significand | 0x0010000000000000ull;
+        v.e = biased - 1075;
+    } else {
+        v.f = significand;
+        v.e = -1074;
+    }
+
+    // Boundaries halfway to the neighbouring doubles, sharing one exponent
+    data_diyfp_t plus = {(v.f << 1) + 1, v.e - 1};
+    while (!(plus.f & (0x0010000000000000ull << 1))) {
+        plus.f <<= 1;
+        plus.e--;
+    }
+    plus.f <<= 10;
+    plus.e -= 10;
+    data_diyfp_t minus;
+    if (v.f == 0x0010000000000000ull) {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    } else {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Pick 10^-k so the scaled exponent lands in [-60, -32]
+    double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    int32_t ik = (int32_t)dk;
+    if (dk - ik > 0.0) {
+        ik++;
+    }
+    uint32_t index = (uint32_t)((ik >> 3) + 1);
+    *k = -(-348 + (int32_t)index * 8);
+    data_diyfp_t c = data_cached_powers[index];
+
+    data_diyfp_t w = data_diyfp_mul(data_diyfp_normalize(v), c);
+    data_diyfp_t wp = data_diyfp_mul(plus, c);
+    data_diyfp_t wm = data_diyfp_mul(minus, c);
+    wm.f++;
+    wp.f--;
+
+    uint64_t delta = wp.f - wm.f;
+    uint64_t wp_w = wp.f - w.f;
+    int32_t shift = -wp.e;
+    uint64_t one = 1ull << shift;
+    uint32_t p1 = (uint32_t)(wp.f >> shift);
+    uint64_t p2 = wp.f & (one - 1);
+    int32_t kappa = 1;
+    while (kappa < 10 && p1 >= data_pow10_u32[kappa]) {
+        kappa++;
+    }
+    uint64_t len = 0;
+    while (kappa > 0) {
+        uint32_t div = data_pow10_u32[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+        if (d || len) {
+            buf[len++] = (char)('0' + d);
+        }
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            data_grisu_round(buf, len, delta, rest, (uint64_t)data_pow10_u32[kappa] << shift, wp_w);
+            return len;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        uint32_t d = (uint32_t)(p2 >> shift);
+        if (d || len) {
+            buf[len++] = (char)('0' + d);
+        }
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta) {
+            *k += kappa;
+            uint64_t unit = -kappa < 10 ? data_pow10_u32[-kappa] : 0;
+            data_grisu_round(buf, len, delta, p2, one, wp_w * unit);
+            return len;
+        }
+    }
+}
+
+static uint64_t data_format_exponent(char* out, int32_t exp) {
+    uint64_t len = 0;
+    if (exp < 0) {
+        out[len++] = '-';
+        exp = -exp;
+    }
+    return len + data_format_uint(out + len, (uint64_t)exp);
+}
+
+// out must hold DATA_NUMBER_MAXSIZE bytes
+static result_t data_format_double(char* out, double value, uint64_t* len) {
+    if (value != value || value - value != 0.0) {
+        RETURN_ERR("Cannot format non-finite double");
+    }
+    uint64_t n = 0;
+    if (signbit(value)) {
+        out[n++] = '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        out[n++] = '0';
+        *len = n;
+        return RESULT_OK;
+    }
+    char* buf = out + n;
+    int32_t k;
+    int32_t digits = (int32_t)data_grisu2(value, buf, &k);
+    int32_t kk = digits + k;
+    if (k >= 0 && kk <= 21) {
+        // 1234e7 -> 12340000000
+        memset(buf + digits, '0', (size_t)k);
+        n += (uint64_t)kk;
+    } else if (kk > 0 && kk <= 21) {
+        // 1234e-2 -> 12.34
+        memmove(buf + kk + 1, buf + kk, (size_t)(digits - kk));
+        buf[kk] = '.';
+        n += (uint64_t)digits + 1;
+    } else if (kk > -6 && kk <= 0) {
+        // 1234e-6 -> 0.001234
+        int32_t offset = 2 - kk;
+        memmove(buf + offset, buf, (size_t)digits);
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(buf + 2, '0', (size_t)(offset - 2));
+        n += (uint64_t)(digits + offset);
+    } else if (digits == 1) {
+        // 1e30
+        buf[1] = 'e';
+        n += 2 + data_format_exponent(buf + 2, kk - 1);
+    } else {
+        // 1234e30 -> 1.234e33
+        memmove(buf + 2, buf + 1, (size_t)(digits - 1));
+        buf[1] = '.';
+        buf[digits + 1] = 'e';
+        n += (uint64_t)digits + 2 + data_format_exponent(buf + digits + 2, kk - 1);
+    }
+    *len = n;
+    return RESULT_OK;
+}
+
+result_t data_append_int(pool_t* pool, data_t** data, int64_t value) {
+    char buf[DATA_NUMBER_MAXSIZE];
+    uint64_t len = data_format_int(buf, value);
+    data_view_t view = {buf, len};
+    if (data_append_view(pool, data, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to append integer to data");
+    }
+    return RESULT_OK;
+}
+
+result_t data_append_double(pool_t* pool, data_t** data, double value) {
+    char buf[DATA_NUMBER_MAXSIZE];
+    uint64_t len;
+    if (data_format_double(buf, value, &len) != RESULT_OK) {
+        RETURN_ERR("Failed to format double");
+    }
+    data_view_t view = {buf, len};
+    if (data_append_view(pool, data, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to append double to data");
+    }
+    return RESULT_OK;
+}
+
+// Data rope
+// A rope is a chain of pool segments linked through object_t nodes. Appends
+// fill the tail segment and start a new one when it is full, so nothing
+// already written is ever copied. Segments grow with the rope up to
+// DATA_ROPE_SEGMENT_MAXSIZE; the content is flattened once at the end or
+// handed to writev directly.
+void data_rope_init(data_rope_t* rope) {
+    rope->head = NULL;
+    rope->tail = NULL;
+    rope->size = 0;
+}
+
+result_t data_rope_destroy(pool_t* pool, data_rope_t* rope) {
+    object_t* segment = rope->head;
+    while (segment) {
+        object_t* next = segment->next;
+        if (data_destroy(pool, segment->data) != RESULT_OK) {
+            RETURN_ERR("Failed to free rope segment");
+        }
+        if (pool_object_free(pool, segment) != RESULT_OK) {
+            RETURN_ERR("Failed to free rope node");
+        }
+        segment = next;
+    }
+    data_rope_init(rope);
+    return RESULT_OK;
+}
+
+static result_t data_rope_extend(pool_t* pool, data_rope_t* rope, uint64_t size) {
+    uint64_t capacity = rope->size;
+    if (capacity < DATA_ROPE_SEGMENT_MINSIZE) {
+        capacity = DATA_ROPE_SEGMENT_MINSIZE;
+    }
+    if (capacity > DATA_ROPE_SEGMENT_MAXSIZE) {
+        capacity = DATA_ROPE_SEGMENT_MAXSIZE;
+    }
+    if (capacity < size) {
+        capacity = size;
+    }
+    object_t* segment = NULL;
+    if (pool_object_alloc(pool, &segment) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate rope node");
+    }
+    if (pool_data_alloc(pool, &segment->data, capacity) != RESULT_OK) {
+        if (pool_object_free(pool, segment) != RESULT_OK) {
+            PRINT_ERR("Failed to free rope node during cleanup");
+        }
+        RETURN_ERR("Failed to allocate rope segment");
+    }
+    segment->data->size = 0;
+    if (rope->tail) {
+        rope->tail->next = segment;
+    } else {
+        rope->head = segment;
+    }
+    rope->tail = segment;
+    return RESULT_OK;
+}
+
+result_t data_rope_reserve(pool_t* pool, data_rope_t* rope, uint64_t size) {
+    if (rope->tail && rope->tail->data->capacity - rope->tail->data->size >= size) {
+        return RESULT_OK;
+    }
+    if (data_rope_extend(pool, rope, size) != RESULT_OK) {
+        RETURN_ERR("Failed to extend rope");
+    }
+    return RESULT_OK;
+}
+
+result_t data_rope_append_view(pool_t* pool, data_rope_t* rope, const data_view_t* view) {
+    if (rope->tail && rope->tail->data->capacity - rope->tail->data->size >= view->size) {
+        memcpy(rope->tail->data->data + rope->tail->data->size, view->data, view->size);
+        rope->tail->data->size += view->size;
+        rope->size += view->size;
+        return RESULT_OK;
+    }
+    const char* p = view->data;
+    uint64_t left = view->size;
+    while (left > 0) {
+        if (!rope->tail || rope->tail->data->size == rope->tail->data->capacity) {
+            if (data_rope_extend(pool, rope, 1) != RESULT_OK) {
+                RETURN_ERR("Failed to extend rope");
+            }
+        }
+        data_t* tail = rope->tail->data;
+        uint64_t n = tail->capacity - tail->size;
+        if (n > left) {
+            n = left;
+        }
+        memcpy(tail->data + tail->size, p, n);
+        tail->size += n;
+        rope->size += n;
+        p += n;
+        left -= n;
+    }
+    return RESULT_OK;
+}
+
+result_t data_rope_append_data(pool_t* pool, data_rope_t* rope, const data_t* data) {
+    data_view_t view = data_view_data(data);
+    return data_rope_append_view(pool, rope, &view);
+}
+
+result_t data_rope_append_str(pool_t* pool, data_rope_t* rope, const char* str) {
+    data_view_t view = data_view_str(str);
+    return data_rope_append_view(pool, rope, &view);
+}
+
+result_t data_rope_append_char(pool_t* pool, data_rope_t* rope, char c) {
+    if (!rope->tail || rope->tail->data->size == rope->tail->data->capacity) {
+        if (data_rope_extend(pool, rope, 1) != RESULT_OK) {
+            RETURN_ERR("Failed to extend rope");
+        }
+    }
+    rope->tail->data->data[rope->tail->data->size++] = c;
+    rope->size++;
+    return RESULT_OK;
+}
+
+result_t data_rope_append_int(pool_t* pool, data_rope_t* rope, int64_t value) {
+    char buf[DATA_NUMBER_MAXSIZE];
+    data_view_t view = {buf, data_format_int(buf, value)};
+    if (data_rope_append_view(pool, rope, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to append integer to rope");
+    }
+    return RESULT_OK;
+}
+
+result_t data_rope_append_double(pool_t* pool, data_rope_t* rope, double value) {
+    char buf[DATA_NUMBER_MAXSIZE];
+    uint64_t len;
+    if (data_format_double(buf, value, &len) != RESULT_OK) {
+        RETURN_ERR("Failed to format double");
+    }
+    data_view_t view = {buf, len};
+    if (data_rope_append_view(pool, rope, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to append double to rope");
+    }
+    return RESULT_OK;
+}
+
+result_t data_rope_append_escape_json(pool_t* pool, data_rope_t* rope, const data_t* src) {
+    if (!src || src->size == 0) {
+        return RESULT_OK;
+    }
+    if (data_rope_reserve(pool, rope, src->size * 6) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve rope for escaped JSON");
+    }
+    uint64_t before = rope->tail->data->size;
+    if (data_append_escape_json(pool, &rope->tail->data, src) != RESULT_OK) {
+        RETURN_ERR("Failed to escape JSON into rope");
+    }
+    rope->size += rope->tail->data->size - before;
+    return RESULT_OK;
+}
+
+result_t data_rope_flatten(pool_t* pool, data_t** dst, const data_rope_t* rope) {
+    if (!*dst) {
+        if (pool_data_alloc(pool, dst, rope->size) != RESULT_OK) {
+            RETURN_ERR("Failed to allocate flattened rope");
+        }
+    } else {
+        if (data_make_private(pool, dst, rope->size) != RESULT_OK) {
+            RETURN_ERR("Failed to make destination private for flattened rope");
+        }
+        (*dst)->size = 0;
+        if (pool_data_realloc(pool, dst, rope->size) != RESULT_OK) {
+            RETURN_ERR("Failed to resize destination for flattened rope");
+        }
+    }
+    char* out = (*dst)->data;
+    for (const object_t* segment = rope->head; segment; segment = segment->next) {
+        memcpy(out, segment->data->data, segment->data->size);
+        out += segment->data->size;
+    }
+    (*dst)->size = rope->size;
+    return RESULT_OK;
+}
+
+result_t data_rope_write(int fd, const data_rope_t* rope) {
+    struct iovec iov[DATA_ROPE_IOV_MAXCOUNT];
+    const object_t* segment = rope->head;
+    uint64_t offset = 0;
+    while (segment) {
+        int count = 0;
+        for (const object_t* s = segment; s && count < DATA_ROPE_IOV_MAXCOUNT; s = s->next) {
+            uint64_t skip = s == segment ? offset : 0;
+            iov[count].iov_base = s->data->data + skip;
+            iov[count].iov_len = s->data->size - skip;
+            count++;
+        }
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            RETURN_ERR("Failed to write rope");
+        }
+        uint64_t left = (uint64_t)written;
+        while (segment && left >= segment->data->size - offset) {
+            left -= segment->data->size - offset;
+            segment = segment->next;
+            offset = 0;
+        }
+        offset += left;
+    }
+    return RESULT_OK;
+}
+
+// Data view
+// Views borrow the bytes of a data_t or string without copying; they stay
+// valid only as long as the buffer they point into is neither freed nor
+// reallocated.
+data_view_t data_view_data(const data_t* data) {
+    data_view_t view = {data->data, data->size};
+    return view;
+}
+
+data_view_t data_view_str(const char* str) {
+    data_view_t view = {str, strlen(str)};
+    return view;
+}
+
+result_t data_view_slice(data_view_t* dst, const data_view_t* src, uint64_t index, uint64_t size) {
+    if (index > src->size || size > src->size - index) {
+        RETURN_ERR("View slice is out of bounds");
+    }
+    dst->data = src->data + index;
+    dst->size = size;
+    return RESULT_OK;
+}
+
+result_t data_create_view(pool_t* pool, data_t** data, const data_view_t* view) {
+    if (pool_data_alloc(pool, data, view->size) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate data with sufficient capacity");
+    }
+    (*data)->size = view->size;
+    memcpy((*data)->data, view->data, view->size);
+    return RESULT_OK;
+}
+
+result_t data_copy_view(pool_t* pool, data_t** data, const data_view_t* view) {
+    if (data_make_private(pool, data, view->size) != RESULT_OK) {
+        RETURN_ERR("Failed to make data private before copying");
+    }
+    (*data)->size = 0;
+    if (pool_data_realloc(pool, data, view->size) != RESULT_OK) {
+        RETURN_ERR("Failed to reallocate data with sufficient capacity");
+    }
+    (*data)->size = view->size;
+    memcpy((*data)->data, view->data, view->size);
+    return RESULT_OK;
+}
+
+result_t data_append_view(pool_t* pool, data_t** data, const data_view_t* view) {
+    if ((*data)->hash != 0 || (*data)->size + view->size > (*data)->capacity) {
+        if (data_grow(pool, data, (*data)->size + view->size) != RESULT_OK) {
+            RETURN_ERR("Failed to reallocate data with sufficient capacity");
+        }
+    }
+    memcpy((*data)->data + (*data)->size, view->data, view->size);
+    (*data)->size += view->size;
+    return RESULT_OK;
+}
+
+result_t data_view_toint(const data_view_t* view, int64_t* dst) {
+    if (view->size == 0) {
+        RETURN_ERR("Cannot convert empty data to integer");
+    }
+    uint64_t i = 0;
+    uint64_t neg = view->data[0] == '-';
+    if (neg) {
+        i = 1;
+        if (view->size == 1) {
+            RETURN_ERR("Invalid character in data");
+        }
+    }
+    uint64_t limit = neg ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t value = 0;
+    while (i < view->size) {
+        uint64_t d = (uint64_t)(unsigned char)view->data[i] - '0';
+        if (d > 9) {
+            RETURN_ERR("Invalid character in data");
+        }
+        if (value > (limit - d) / 10) {
+            RETURN_ERR("Integer out of range");
+        }
+        value = value * 10 + d;
+        i++;
+    }
+    *dst = neg ? (int64_t)((uint64_t)0 - value) : (int64_t)value;
+    return RESULT_OK;
+}
+
+// Accepts JSON number syntax. Up to 19 significant digits with a small
+// decimal exponent convert exactly with one multiply or divide when the
+// digits fit the 53-bit mantissa; anything else goes through strtod on a
+// terminated copy.
+result_t data_view_todouble(const data_view_t* view, double* dst) {
+    static const double pow10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* p = view->data;
+    const char* end = p + view->size;
+    uint64_t neg = p < end && *p == '-';
+    if (neg) {
+        p++;
+    }
+    if (p >= end || (unsigned char)(*p - '0') > 9) {
+        RETURN_ERR("Invalid number in data");
+    }
+    if (*p == '0' && p + 1 < end && (unsigned char)(p[1] - '0') <= 9) {
+        RETURN_ERR("Leading zero in number");
+    }
+    uint64_t mantissa = 0;
+    int64_t digits = 0;
+    int64_t exp10 = 0;
+    while (p < end && (unsigned char)(*p - '0') <= 9) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digits += mantissa != 0;
+        } else {
+            exp10++;
+            digits++;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        if (p >= end || (unsigned char)(*p - '0') > 9) {
+            RETURN_ERR("Invalid number in data");
+        }
+        while (p < end && (unsigned char)(*p - '0') <= 9) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                digits += mantissa != 0;
+                exp10--;
+            } else {
+                digits++;
+            }
+            p++;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int64_t exp_sign = 1;
+        if (p < end && (*p == '+' || *p == '-')) {
+            exp_sign = *p == '-' ? -1 : 1;
+            p++;
+        }
+        if (p >= end || (unsigned char)(*p - '0') > 9) {
+            RETURN_ERR("Invalid number in data");
+        }
+        int64_t exp = 0;
+        while (p < end && (unsigned char)(*p - '0') <= 9) {
+            if (exp < 100000) {
+                exp = exp * 10 + (*p - '0');
+            }
+            p++;
+        }
+        exp10 += exp_sign * exp;
+    }
+    if (p != end) {
+        RETURN_ERR("Invalid character in data");
+    }
+
+    double value;
+    if (digits <= 19 && mantissa <= (1ull << 53) && exp10 >= -22 && exp10 <= 22) {
+        value = (double)mantissa;
+        value = exp10 < 0 ? value / pow10[-exp10] : value * pow10[exp10];
+    } else {
+        char buf[DATA_NUMBER_LITERAL_MAXSIZE];
+        if (view->size >= sizeof(buf)) {
+            RETURN_ERR("Number literal too long");
+        }
+        memcpy(buf, view->data, view->size);
+        buf[view->size] = '\0';
+        value = strtod(buf, NULL);
+        neg = 0;
+    }
+    if (value - value != 0.0) {
+        RETURN_ERR("Number out of range");
+    }
+    *dst = neg ? -value : value;
+    return RESULT_OK;
+}
+
+// 64-bit multiply-rotate hash over 8-byte words with a murmur3 finalizer.
+// Never returns 0, which data_t.hash reserves for "not interned".
+uint64_t data_view_hash(const data_view_t* view) {
+    const char* p = view->data;
+    uint64_t n = view->size;
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ n;
+    while (n >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h ^= w * 0x87C37B91114253D5ull;
+        h = ((h << 31) | (h >> 33)) * 0x4CF5AD432745937Full;
+        p += 8;
+        n -= 8;
+    }
+    if (n > 0) {
+        uint64_t w = 0;
+        memcpy(&w, p, n);
+        h ^= w * 0x87C37B91114253D5ull;
+        h = ((h << 31) | (h >> 33)) * 0x4CF5AD432745937Full;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h != 0 ? h : 1;
+}
+
+uint64_t data_view_equal_view(const data_view_t* view1, const data_view_t* view2) {
+    if (view1->size != view2->size) {
+        return 0;
+    }
+    return memcmp(view1->data, view2->data, view1->size) == 0;
+}
+
+uint64_t data_view_equal_str(const data_view_t* view, const char* str) {
+    size_t len = strlen(str);
+    if (view->size != len) {
+        return 0;
+    }
+    return memcmp(view->data, str, len) == 0;
+}
+
+int64_t data_view_find_view(const data_view_t* view1, const data_view_t* view2, uint64_t index) {
+    if (index >= view1->size || view2->size == 0) {
+        return -1;
+    }
+    const char* pos = data_find(view1->data + index, view2->data, view1->size - index, view2->size);
+    if (!pos) {
+        return -1;
+    }
+    return pos - view1->data;
+}
+
+int64_t data_view_find_str(const data_view_t* view, const char* str, uint64_t index) {
+    if (index >= view->size || !str || *str == '\0') {
+        return -1;
+    }
+    const char* pos = data_find(view->data + index, str, view->size - index, strlen(str));
+    if (!pos) {
+        return -1;
+    }
+    return pos - view->data;
+}
+
+int64_t data_view_find_char(const data_view_t* view, char c, uint64_t index) {
+    if (index >= view->size) {
+        return -1;
+    }
+    const char* pos = memchr(view->data + index, c, view->size - index);
+    if (!pos) {
+        return -1;
+    }
+    return pos - view->data;
+}
+
+// Bytes that JSON strings must escape: quote, backslash and controls.
+static const char* data_json_special_scalar(const char* p, const char* end) {
+    while (p < end && *p != '"' && *p != '\\' && (unsigned char)*p >= 0x20) {
+        p++;
+    }
+    return p;
+}
+
+#if defined(__x86_64__)
+static const char* data_json_special_sse2(const char* p, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash));
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(_mm_max_epu8(block, control), control));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return data_json_special_scalar(p, end);
+}
+
+__attribute__((target("avx2"))) static const char* data_json_special_avx2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1f);
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash));
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(_mm256_max_epu8(block, control), control));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return data_json_special_scalar(p, end);
+}
+#endif
+
+static const char* data_json_special(const char* p, const char* end) {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return data_json_special_avx2(p, end);
+    }
+    return data_json_special_sse2(p, end);
+#else
+    return data_json_special_scalar(p, end);
+#endif
+}
+
+// Reserves the worst case (every byte as \u00XX) up front, then copies runs
+// of safe bytes with memcpy and writes escapes only at special bytes.
+result_t data_append_escape_json(pool_t* pool, data_t** dst, const data_t* src) {
+    if (!src || src->size == 0) {
+        return RESULT_OK;
+    }
+    if (data_reserve(pool, dst, src->size * 6) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for escaped JSON");
+    }
+    static const char hex[] = "0123456789abcdef";
+    const char* p = src->data;
+    const char* end = src->data + src->size;
+    char* out = (*dst)->data + (*dst)->size;
+    while (p < end) {
+        const char* special = data_json_special(p, end);
+        memcpy(out, p, (size_t)(special - p));
+        out += special - p;
+        if (special == end) {
+            break;
+        }
+        unsigned char c = (unsigned char)*special;
+        *out++ = '\\';
+        switch (c) {
+            case '"':
+                *out++ = '"';
+                break;
+            case '\\':
+                *out++ = '\\';
+                break;
+            case '\b':
+                *out++ = 'b';
+                break;
+            case '\f':
+                *out++ = 'f';
+                break;
+            case '\n':
+                *out++ = 'n';
+                break;
+            case '\r':
+                *out++ = 'r';
+                break;
+            case '\t':
+                *out++ = 't';
+                break;
+            default:
+                memcpy(out, "u00", 3);
+                out[3] = hex[c >> 4];
+                out[4] = hex[c & 0xf];
+                out += 5;
+                break;
+        }
+        p = special + 1;
+    }
+    (*dst)->size = (uint64_t)(out - (*dst)->data);
+    return RESULT_OK;
+}
+
+result_t data_escape_json(pool_t* pool, data_t** data) {
+    data_t* result = NULL;
+    if (data_create(pool, &result) != RESULT_OK) {
+        RETURN_ERR("Failed to create result data");
+    }
+    if (data_append_escape_json(pool, &result, *data) != RESULT_OK) {
+        if (data_destroy(pool, result) != RESULT_OK) {
+            PRINT_ERR("Failed to destroy result data during cleanup");
+        }
+        RETURN_ERR("Failed to escape JSON data");
+    }
+    data_t* old_data = *data;
+    *data = result;
+    if (data_destroy(pool, old_data) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy old data");
+    }
+    return RESULT_OK;
+}
+
+static int hex_char_to_int(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static int64_t data_hex4(const char* p) {
+    int64_t value = 0;
+    for (uint64_t i = 0; i < 4; i++) {
+        int digit = hex_char_to_int(p[i]);
+        if (digit < 0) {
+            return -1;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+static uint64_t data_utf8_encode(char* out, uint32_t cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xc0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3f));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xe0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3f));
+        out[2] = (char)(0x80 | (cp & 0x3f));
+        return 3;
+    }
+    out[0] = (char)(0xf0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3f));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3f));
+    out[3] = (char)(0x80 | (cp & 0x3f));
+    return 4;
+}
+
+// Every escape decodes to no more bytes than it occupies, so reserving the
+// raw length is enough. Escape-free runs are copied whole. \uXXXX becomes
+// UTF-8, surrogate pairs are combined and lone surrogates become U+FFFD.
+// Malformed \u escapes are kept verbatim; other unknown escapes keep just
+// the escaped character.
+result_t data_append_unescape_json(pool_t* pool, data_t** dst, const char* src, uint64_t size) {
+    if (size == 0) {
+        return RESULT_OK;
+    }
+    if (data_reserve(pool, dst, size) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for unescaped JSON");
+    }
+    const char* p = src;
+    const char* end = src + size;
+    char* out = (*dst)->data + (*dst)->size;
+    while (p < end) {
+        const char* esc = memchr(p, '\\', (size_t)(end - p));
+        if (esc == NULL) {
+            esc = end;
+        }
+        memcpy(out, p, (size_t)(esc - p));
+        out += esc - p;
+        if (esc == end) {
+            break;
+        }
+        if (esc + 1 == end) {
+            *out++ = '\\';
+            break;
+        }
+        p = esc + 2;
+        switch (esc[1]) {
+            case 'b':
+                *out++ = '\b';
+                break;
+            case 'f':
+                *out++ = '\f';
+                break;
+            case 'n':
+                *out++ = '\n';
+                break;
+            case 'r':
+                *out++ = '\r';
+                break;
+            case 't':
+                *out++ = '\t';
+                break;
+            case 'u': {
+                int64_t cp = end - esc >= 6 ? data_hex4(esc + 2) : -1;
+                if (cp < 0) {
+                    *out++ = '\\';
+                    *out++ = 'u';
+                    break;
+                }
+                p = esc + 6;
+                if (cp >= 0xd800 && cp <= 0xdbff) {
+                    int64_t low = end - p >= 6 && p[0] == '\\' && p[1] == 'u' ? data_hex4(p + 2) : -1;
+                    if (low >= 0xdc00 && low <= 0xdfff) {
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                        p += 6;
+                    } else {
+                        cp = 0xfffd;
+                    }
+                } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+                    cp = 0xfffd;
+                }
+                out += data_utf8_encode(out, (uint32_t)cp);
+                break;
+            }
+            default:
+                *out++ = esc[1];
+                break;
+        }
+    }
+    (*dst)->size = (uint64_t)(out - (*dst)->data);
+    return RESULT_OK;
+}
+
+result_t data_unescape_json(pool_t* pool, data_t** data) {
+    data_t* result = NULL;
+    if (pool_data_alloc(pool, &result, (*data)->size) != RESULT_OK) {
+        RETURN_ERR("Failed to create result data");
+    }
+    result->size = 0;
+    if (data_append_unescape_json(pool, &result, (*data)->data, (*data)->size) != RESULT_OK) {
+        if (data_destroy(pool, result) != RESULT_OK) {
+            PRINT_ERR("Failed to destroy result data during cleanup");
+        }
+        RETURN_ERR("Failed to unescape JSON data");
+    }
+    data_t* old_data = *data;
+    *data = result;
+    if (data_destroy(pool, old_data) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy old data");
+    }
+    return RESULT_OK;
+}
+
+// Data base64 and hex
+// Encoders and decoders reserve the whole output once and write straight
+// into it. The AVX2 base64 kernels follow Mula: encoding spreads 24 input
+// bytes into 32 six-bit indices with two multiplies and maps them to ASCII
+// with one shuffle lookup; decoding validates 32 characters with two nibble
+// lookups, translates them with a per-range offset and packs the 6-bit
+// values with multiply-adds. Hex works on nibbles with SSE2 or AVX2. Vector
+// loops stop at the first block holding an invalid character and leave it
+// to the scalar loop, which reports the error.
+static const char data_base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const int8_t data_base64_table[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,};
+
+static char* data_base64_encode_scalar(const unsigned char* p, uint64_t n, char* out) {
+    uint64_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        uint32_t v = (uint32_t)p[i] << 16 | (uint32_t)p[i + 1] << 8 | p[i + 2];
+        out[0] = data_base64_alphabet[v >> 18];
+        out[1] = data_base64_alphabet[(v >> 12) & 0x3F];
+        out[2] = data_base64_alphabet[(v >> 6) & 0x3F];
+        out[3] = data_base64_alphabet[v & 0x3F];
+        out += 4;
+    }
+    if (n - i == 1) {
+        uint32_t v = (uint32_t)p[i] << 16;
+        out[0] = data_base64_alphabet[v >> 18];
+        out[1] = data_base64_alphabet[(v >> 12) & 0x3F];
+        out[2] = '=';
+        out[3] = '=';
+        out += 4;
+    } else if (n - i == 2) {
+        uint32_t v = (uint32_t)p[i] << 16 | (uint32_t)p[i + 1] << 8;
+        out[0] = data_base64_alphabet[v >> 18];
+        out[1] = data_base64_alphabet[(v >> 12) & 0x3F];
+        out[2] = data_base64_alphabet[(v >> 6) & 0x3F];
+        out[3] = '=';
+        out += 4;
+    }
+    return out;
+}
+
+// Decodes n characters without padding; returns NULL on an invalid one
+static unsigned char* data_base64_decode_scalar(const unsigned char* p, uint64_t n, unsigned char* out) {
+    uint64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32_t a = data_base64_table[p[i]];
+        int32_t b = data_base64_table[p[i + 1]];
+        int32_t c = data_base64_table[p[i + 2]];
+        int32_t d = data_base64_table[p[i + 3]];
+        if ((a | b | c | d) < 0) {
+            return NULL;
+        }
+        uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6 | (uint32_t)d;
+        out[0] = (unsigned char)(v >> 16);
+        out[1] = (unsigned char)(v >> 8);
+        out[2] = (unsigned char)v;
+        out += 3;
+    }
+    if (n - i >= 2) {
+        int32_t a = data_base64_table[p[i]];
+        int32_t b = data_base64_table[p[i + 1]];
+        int32_t c = n - i == 3 ? data_base64_table[p[i + 2]] : 0;
+        if ((a | b | c) < 0) {
+            return NULL;
+        }
+        uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6;
+        *out++ = (unsigned char)(v >> 16);
+        if (n - i == 3) {
+            *out++ = (unsigned char)(v >> 8);
+        }
+    }
+    return out;
+}
+
+static char* data_hex_encode_scalar(const unsigned char* p, uint64_t n, char* out) {
+    static const char hex[] = "0123456789abcdef";
+    for (uint64_t i = 0; i < n; i++) {
+        *out++ = hex[p[i] >> 4];
+        *out++ = hex[p[i] & 0xF];
+    }
+    return out;
+}
+
+static unsigned char* data_hex_decode_scalar(const char* p, uint64_t n, unsigned char* out) {
+    for (uint64_t i = 0; i + 2 <= n; i += 2) {
+        int hi = hex_char_to_int(p[i]);
+        int lo = hex_char_to_int(p[i + 1]);
+        if (hi < 0 || lo < 0) {
+            return NULL;
+        }
+        *out++ = (unsigned char)(hi << 4 | lo);
+    }
+    return out;
+}
+
+#if defined(__x86_64__)
+static uint64_t data_hex_encode_sse2(const unsigned char* p, uint64_t n, char* out) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i digit = _mm_set1_epi8('0');
+    const __m128i letter = _mm_set1_epi8('a' - '0' - 10);
+    uint64_t i = 0;
+    for (; n - i >= 16; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+        __m128i lo = _mm_and_si128(v, nibble);
+        __m128i a = _mm_unpacklo_epi8(hi, lo);
+        __m128i b = _mm_unpackhi_epi8(hi, lo);
+        a = _mm_add_epi8(_mm_add_epi8(a, digit), _mm_and_si128(_mm_cmpgt_epi8(a, nine), letter));
+        b = _mm_add_epi8(_mm_add_epi8(b, digit), _mm_and_si128(_mm_cmpgt_epi8(b, nine), letter));
+        _mm_storeu_si128((__m128i*)(out + i * 2), a);
+        _mm_storeu_si128((__m128i*)(out + i * 2 + 16), b);
+    }
+    return i;
+}
+
+static uint64_t data_hex_nibbles_sse2(__m128i c, __m128i* value) {
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+    if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xFFFF) {
+        return 0;
+    }
+    *value = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                          _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    return 1;
+}
+
+static uint64_t data_hex_decode_sse2(const char* p, uint64_t n, unsigned char* out) {
+    const __m128i low = _mm_set1_epi16(0x00FF);
+    uint64_t i = 0;
+    for (; n - i >= 32; i += 32) {
+        __m128i a, b;
+        if (!data_hex_nibbles_sse2(_mm_loadu_si128((const __m128i*)(p + i)), &a) ||
+            !data_hex_nibbles_sse2(_mm_loadu_si128((const __m128i*)(p + i + 16)), &b)) {
+            break;
+        }
+        // Each 16-bit lane holds the high nibble in its low byte
+        a = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(a, low), 4), _mm_srli_epi16(a, 8));
+        b = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b, low), 4), _mm_srli_epi16(b, 8));
+        _mm_storeu_si128((__m128i*)(out + i / 2), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static uint64_t data_hex_encode_avx2(const unsigned char* p, uint64_t n, char* out) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i digit = _mm256_set1_epi8('0');
+    const __m256i letter = _mm256_set1_epi8('a' - '0' - 10);
+    uint64_t i = 0;
+    for (; n - i >= 32; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+        __m256i lo = _mm256_and_si256(v, nibble);
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        a = _mm256_add_epi8(_mm256_add_epi8(a, digit), _mm256_and_si256(_mm256_cmpgt_epi8(a, nine), letter));
+        b = _mm256_add_epi8(_mm256_add_epi8(b, digit), _mm256_and_si256(_mm256_cmpgt_epi8(b, nine), letter));
+        // Unpacks work per 128-bit lane; put the four quarters back in order
+        _mm256_storeu_si256((__m256i*)(out + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static uint64_t data_hex_nibbles_avx2(__m256i c, __m256i* value) {
+    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+    if ((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(digit, letter)) != 0xFFFFFFFFu) {
+        return 0;
+    }
+    *value = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                             _mm256_and_si256(letter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+    return 1;
+}
+
+__attribute__((target("avx2"))) static uint64_t data_hex_decode_avx2(const char* p, uint64_t n, unsigned char* out) {
+    const __m256i low = _mm256_set1_epi16(0x00FF);
+    uint64_t i = 0;
+    for (; n - i >= 64; i += 64) {
+        __m256i a, b;
+        if (!data_hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(p + i)), &a) ||
+            !data_hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(p + i + 32)), &b)) {
+            break;
+        }
+        a = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(a, low), 4), _mm256_srli_epi16(a, 8));
+        b = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(b, low), 4), _mm256_srli_epi16(b, 8));
+        _mm256_storeu_si256((__m256i*)(out + i / 2), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+    }
+    return i;
+}
+
+// Needs 28 readable input bytes per step: each lane loads 16 bytes for 12
+__attribute__((target("avx2"))) static uint64_t data_base64_encode_avx2(const unsigned char* p, uint64_t n, char* out) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i shift_lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                               '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                               'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                               '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    uint64_t i = 0;
+    for (; n - i >= 28; i += 24) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(p + i + 12));
+        __m256i in = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), spread);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t0, t1);
+        // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i*)(out + i / 3 * 4), _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift_lut, reduced)));
+    }
+    return i;
+}
+
+// Writes 32 bytes per 24 decoded, so the output needs 8 bytes of slack
+__attribute__((target("avx2"))) static uint64_t data_base64_decode_avx2(const char* p, uint64_t n, unsigned char* out) {
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    uint64_t i = 0;
+    for (; n - i >= 32; i += 32) {
+        __m256i in = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+        __m256i lo_nibbles = _mm256_and_si256(in, nibble);
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lut_lo, lo_nibbles), _mm256_shuffle_epi8(lut_hi, hi_nibbles))) {
+            break;
+        }
+        __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        __m256i values = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(slash, hi_nibbles)));
+        __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i packed = _mm256_shuffle_epi8(_mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000)), pack);
+        packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256((__m256i*)(out + i / 4 * 3), packed);
+    }
+    return i;
+}
+#endif
+
+result_t data_append_base64(pool_t* pool, data_t** dst, const data_t* src) {
+    if (data_reserve(pool, dst, (src->size + 2) / 3 * 4) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for base64 output");
+    }
+    const unsigned char* p = (const unsigned char*)src->data;
+    char* out = (*dst)->data + (*dst)->size;
+    uint64_t done = 0;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        done = data_base64_encode_avx2(p, src->size, out);
+    }
+#endif
+    out = data_base64_encode_scalar(p + done, src->size - done, out + done / 3 * 4);
+    (*dst)->size = (uint64_t)(out - (*dst)->data);
+    return RESULT_OK;
+}
+
+// Accepts padded or unpadded standard base64; anything outside the
+// alphabet, including whitespace, is an error and leaves dst unchanged.
+result_t data_decode_base64(pool_t* pool, data_t** dst, const data_t* src) {
+    const char* p = src->data;
+    uint64_t n = src->size;
+    if (n % 4 == 0 && n > 0 && p[n - 1] == '=') {
+        n -= p[n - 2] == '=' ? 2 : 1;
+    }
+    if (n % 4 == 1) {
+        RETURN_ERR("Invalid base64 length");
+    }
+    if (data_reserve(pool, dst, n / 4 * 3 + 2 + 8) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for base64 decoding");
+    }
+    unsigned char* out = (unsigned char*)(*dst)->data + (*dst)->size;
+    uint64_t done = 0;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        done = data_base64_decode_avx2(p, n, out);
+    }
+#endif
+    out = data_base64_decode_scalar((const unsigned char*)p + done, n - done, out + done / 4 * 3);
+    if (out == NULL) {
+        RETURN_ERR("Invalid character in base64 data");
+    }
+    (*dst)->size = (uint64_t)((char*)out - (*dst)->data);
+    return RESULT_OK;
+}
+
+result_t data_append_hex(pool_t* pool, data_t** dst, const data_t* src) {
+    if (data_reserve(pool, dst, src->size * 2) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for hex output");
+    }
+    const unsigned char* p = (const unsigned char*)src->data;
+    char* out = (*dst)->data + (*dst)->size;
+    uint64_t done;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        done = data_hex_encode_avx2(p, src->size, out);
+    } else {
+        done = data_hex_encode_sse2(p, src->size, out);
+    }
+#else
+    done = 0;
+#endif
+    out = data_hex_encode_scalar(p + done, src->size - done, out + done * 2);
+    (*dst)->size = (uint64_t)(out - (*dst)->data);
+    return RESULT_OK;
+}
+
+// Accepts either case; an odd length or a non-hex character is an error
+// and leaves dst unchanged.
+result_t data_decode_hex(pool_t* pool, data_t** dst, const data_t* src) {
+    if (src->size % 2 != 0) {
+        RETURN_ERR("Invalid hex length");
+    }
+    if (data_reserve(pool, dst, src->size / 2) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve buffer for hex decoding");
+    }
+    unsigned char* out = (unsigned char*)(*dst)->data + (*dst)->size;
+    uint64_t done;
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        done = data_hex_decode_avx2(src->data, src->size, out);
+    } else {
+        done = data_hex_decode_sse2(src->data, src->size, out);
+    }
+#else
+    done = 0;
+#endif
+    out = data_hex_decode_scalar(src->data + done, src->size - done, out + done / 2);
+    if (out == NULL) {
+        RETURN_ERR("Invalid character in hex data");
     }
-    
+    (*dst)->size = (uint64_t)((char*)out - (*dst)->data);
     return RESULT_OK;
 }
 
@@ -52,3 +52,18 @@ result_t file_write(const char* path, const data_t* data) {
     }
     return RESULT_OK;
 }
+
+result_t file_write_rope(const char* path, const data_rope_t* rope) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        RETURN_ERR("Failed to open file for writing");
+    }
+    if (data_rope_write(fd, rope) != RESULT_OK) {
+        close(fd);
+        RETURN_ERR("Failed to write entire rope to file");
+    }
+    if (close(fd) != 0) {
+        RETURN_ERR("Failed to close file after writing");
+    }
+    return RESULT_OK;
+}
@@ -54,12 +54,10 @@ static result_t extract_url_components(const data_t* url_data, data_t** host, ui
         }
 
         // Parse port
-        char port_str[8] = {0};
-        uint64_t port_len = host_end - port_start;
-        if (port_len > 0 && port_len < 6) {
-            memcpy(port_str, port_start, port_len);
-            int parsed_port = atoi(port_str);
-            if (parsed_port <= 0 || parsed_port > 65535) {
+        data_view_t port_view = {port_start, (uint64_t)(host_end - port_start)};
+        if (port_view.size > 0 && port_view.size < 6) {
+            int64_t parsed_port = 0;
+            if (data_view_toint(&port_view, &parsed_port) != RESULT_OK || parsed_port <= 0 || parsed_port > 65535) {
                 if (data_destroy(pool, *host) != RESULT_OK) {
                     RETURN_ERR("Failed to destroy host data");
                 }
@@ -172,30 +170,40 @@ static result_t send_http_request(pool_t* pool, int sock_fd, const data_t* reque
     return RESULT_OK;
 }
 
-// Helper function to extract HTTP response body
-static result_t extract_response_body(pool_t* pool, const data_t* raw_response, data_t** body) {
-    // Find the end of headers (double CRLF or double LF)
-    int64_t body_start_crlf = data_find_str(raw_response, "\r\n\r\n", 0);
-    int64_t body_start_lf = data_find_str(raw_response, "\n\n", 0);
-    int64_t body_start = -1;
-
-    if (data_create(pool, body) != RESULT_OK) {
-        RETURN_ERR("Failed to create response body");
+// Helper function to build an HTTP POST request, with an optional Accept header
+static result_t build_post_request(pool_t* pool, const data_t* host, const data_t* path, const data_t* content_type, const char* accept, const data_t* body, data_t** request) {
+    if (data_create(pool, request) != RESULT_OK) {
+        RETURN_ERR("Failed to create HTTP request data");
     }
 
-    if (body_start_crlf >= 0) {
-        body_start = body_start_crlf + 4;
-    } else if (body_start_lf >= 0) {
-        body_start = body_start_lf + 2;
-    } else {
-        // No body separator found - return empty body
-        if (data_clean(pool, body) != RESULT_OK) {
-            RETURN_ERR("Failed to clean empty response body");
+    // Size the request once: headers are small next to the body
+    char content_length[64];
+    snprintf(content_length, sizeof(content_length), "Content-Length: %lu\r\n", body->size);
+    if (data_reserve(pool, request, path->size + host->size + content_type->size + body->size + 192) != RESULT_OK ||
+        data_append_str(pool, request, "POST ") != RESULT_OK ||
+        data_append_data(pool, request, path) != RESULT_OK ||
+        data_append_str(pool, request, " HTTP/1.1\r\nHost: ") != RESULT_OK ||
+        data_append_data(pool, request, host) != RESULT_OK ||
+        data_append_str(pool, request, "\r\nContent-Type: ") != RESULT_OK ||
+        data_append_data(pool, request, content_type) != RESULT_OK ||
+        data_append_str(pool, request, "\r\n") != RESULT_OK ||
+        data_append_str(pool, request, content_length) != RESULT_OK ||
+        (accept && (data_append_str(pool, request, "Accept: ") != RESULT_OK ||
+                    data_append_str(pool, request, accept) != RESULT_OK ||
+                    data_append_str(pool, request, "\r\n") != RESULT_OK)) ||
+        data_append_str(pool, request, "Connection: close\r\n\r\n") != RESULT_OK ||
+        data_append_data(pool, request, body) != RESULT_OK) {
+        if (data_destroy(pool, *request) != RESULT_OK) {
+            RETURN_ERR("Failed to destroy request data after request build failure");
         }
-        return RESULT_OK;
+        RETURN_ERR("Failed to build HTTP POST request");
     }
 
-    // Check status code before extracting body
+    return RESULT_OK;
+}
+
+// Helper function to check the status line of an HTTP response for a 2xx code
+static result_t check_response_status(const data_t* raw_response) {
     if (raw_response->size < 5 || strncmp(raw_response->data, "HTTP/", 5) != 0) {
         RETURN_ERR("Invalid HTTP response format");
     }
@@ -207,66 +215,62 @@ static result_t extract_response_body(pool_t* pool, const data_t* raw_response,
     }
 
     // Extract and parse status code (3 digits after the space)
-    char status_str[4] = {0};
-    for (int i = 0; i < 3 && (first_space + 1 + i) < (int64_t)raw_response->size; i++) {
-        char c = raw_response->data[first_space + 1 + i];
-        if (c < '0' || c > '9') {
-            RETURN_ERR("Invalid status code format");
-        }
-        status_str[i] = c;
+    data_view_t response = data_view_data(raw_response);
+    data_view_t status_view;
+    int64_t status_code = 0;
+    if (data_view_slice(&status_view, &response, (uint64_t)first_space + 1, 3) != RESULT_OK ||
+        data_view_toint(&status_view, &status_code) != RESULT_OK) {
+        RETURN_ERR("Invalid status code format");
     }
-    int status_code = atoi(status_str);
 
     // Check for successful status codes (2xx)
     if (status_code < 200 || status_code >= 300) {
         RETURN_ERR("HTTP request failed with non-2xx status code");
     }
 
-    // Extract body content using data utilities
-    if (body_start < (int64_t)raw_response->size) {
-        uint64_t body_len = raw_response->size - body_start;
-        if (body_len > 0) {
-            // Create a temporary data to hold the body data
-            data_t* temp_body = NULL;
-            if (data_create(pool, &temp_body) != RESULT_OK) {
-                RETURN_ERR("Failed to create temporary body data");
-            }
+    return RESULT_OK;
+}
 
-            // Allocate enough space for the body
-            if (pool_data_realloc(pool, &temp_body, body_len + 1) != RESULT_OK) {
-                if (data_destroy(pool, temp_body) != RESULT_OK) {
-                    RETURN_ERR("Failed to destroy temporary body data");
-                }
-                RETURN_ERR("Failed to allocate space for response body");
-            }
+// Helper function to find where the body starts, after the first double CRLF
+// or double LF that ends the headers; -1 while the headers are incomplete
+static int64_t find_body_start(const data_t* raw_response) {
+    int64_t crlf = data_find_str(raw_response, "\r\n\r\n", 0);
+    int64_t lf = data_find_str(raw_response, "\n\n", 0);
+    if (lf >= 0 && (crlf < 0 || lf < crlf)) {
+        return lf + 2;
+    }
+    return crlf >= 0 ? crlf + 4 : -1;
+}
 
-            // Copy the body data
-            memcpy(temp_body->data, raw_response->data + body_start, body_len);
-            temp_body->data[body_len] = '\0';
-            temp_body->size = body_len;
+// Helper function to extract HTTP response body
+static result_t extract_response_body(pool_t* pool, const data_t* raw_response, data_t** body) {
+    int64_t body_start = find_body_start(raw_response);
 
-            // Copy the body to the output parameter using data utilities
-            if (data_copy_data(pool, body, temp_body) != RESULT_OK) {
-                if (data_destroy(pool, temp_body) != RESULT_OK) {
-                    RETURN_ERR("Failed to destroy temporary body data");
-                }
-                RETURN_ERR("Failed to copy body to output data");
-            }
+    if (data_create(pool, body) != RESULT_OK) {
+        RETURN_ERR("Failed to create response body");
+    }
 
-            if (data_destroy(pool, temp_body) != RESULT_OK) {
-                RETURN_ERR("Failed to destroy temporary body data");
-            }
-        } else {
-            // Empty body
-            if (data_clean(pool, body) != RESULT_OK) {
-                RETURN_ERR("Failed to clean empty response body");
-            }
-        }
-    } else {
-        // Body start is beyond the response size - empty body
+    if (body_start < 0) {
+        // No body separator found - return empty body
         if (data_clean(pool, body) != RESULT_OK) {
             RETURN_ERR("Failed to clean empty response body");
         }
+        return RESULT_OK;
+    }
+
+    // Check status code before extracting body
+    if (check_response_status(raw_response) != RESULT_OK) {
+        RETURN_ERR("HTTP response status check failed");
+    }
+
+    // Slice the body straight out of the raw response
+    data_view_t response = data_view_data(raw_response);
+    data_view_t body_view;
+    if (data_view_slice(&body_view, &response, (uint64_t)body_start, raw_response->size - (uint64_t)body_start) != RESULT_OK) {
+        RETURN_ERR("Invalid response body bounds");
+    }
+    if (data_copy_view(pool, body, &body_view) != RESULT_OK) {
+        RETURN_ERR("Failed to copy body to output data");
     }
 
     return RESULT_OK;
@@ -395,106 +399,458 @@ result_t http_post(pool_t* pool, const data_t* url, const data_t* content_type,
     }
 
     // Create HTTP POST request
-    if (data_create(pool, &request) != RESULT_OK) {
+    if (build_post_request(pool, host, path, content_type, NULL, body, &request) != RESULT_OK) {
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after request creation failure");
+            RETURN_ERR("Failed to destroy host data after request build failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after request creation failure");
+            RETURN_ERR("Failed to destroy path data after request build failure");
         }
-        RETURN_ERR("Failed to create HTTP request data");
+        RETURN_ERR("Failed to build HTTP POST request");
     }
 
-    // Build request line
-    if (data_append_str(pool, &request, "POST ") != RESULT_OK ||
-        data_append_data(pool, &request, path) != RESULT_OK ||
-        data_append_str(pool, &request, " HTTP/1.1\r\n") != RESULT_OK) {
+    // Create connection
+    if (create_connection(host, port, &sock_fd) != RESULT_OK) {
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after request line build failure");
+            RETURN_ERR("Failed to destroy host data after connection failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after request line build failure");
+            RETURN_ERR("Failed to destroy path data after connection failure");
         }
         if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after request line build failure");
+            RETURN_ERR("Failed to destroy request data after connection failure");
         }
-        RETURN_ERR("Failed to build HTTP POST request line");
+        RETURN_ERR("Failed to create connection");
     }
 
-    // Add Host header
-    if (data_append_str(pool, &request, "Host: ") != RESULT_OK ||
-        data_append_data(pool, &request, host) != RESULT_OK ||
-        data_append_str(pool, &request, "\r\n") != RESULT_OK) {
+    // Send request and receive response
+    if (send_http_request(pool, sock_fd, request, &raw_response) != RESULT_OK) {
+        close(sock_fd);
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after host header failure");
+            RETURN_ERR("Failed to destroy host data after request send failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after host header failure");
+            RETURN_ERR("Failed to destroy path data after request send failure");
         }
         if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after host header failure");
+            RETURN_ERR("Failed to destroy request data after request send failure");
         }
-        RETURN_ERR("Failed to add Host header");
+        RETURN_ERR("Failed to send HTTP request and receive response");
     }
 
-    // Add Content-Type header
-    if (data_append_str(pool, &request, "Content-Type: ") != RESULT_OK ||
-        data_append_data(pool, &request, content_type) != RESULT_OK ||
-        data_append_str(pool, &request, "\r\n") != RESULT_OK) {
+    // Extract response body
+    if (extract_response_body(pool, raw_response, response) != RESULT_OK) {
+        close(sock_fd);
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after content type header failure");
+            RETURN_ERR("Failed to destroy host data after body extraction failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after content type header failure");
+            RETURN_ERR("Failed to destroy path data after body extraction failure");
         }
         if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after content type header failure");
+            RETURN_ERR("Failed to destroy request data after body extraction failure");
+        }
+        if (data_destroy(pool, raw_response) != RESULT_OK) {
+            RETURN_ERR("Failed to destroy raw response data after body extraction failure");
         }
-        RETURN_ERR("Failed to add Content-Type header");
+        RETURN_ERR("Failed to extract response body");
     }
 
-    // Add Content-Length header
-    char content_length[64];
-    snprintf(content_length, sizeof(content_length), "Content-Length: %lu\r\n", body->size);
-    if (data_append_str(pool, &request, content_length) != RESULT_OK) {
-        if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after content length header failure");
-        }
-        if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after content length header failure");
+    // Clean up all resources
+    close(sock_fd);
+    if (data_destroy(pool, host) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy host data");
+    }
+    if (data_destroy(pool, path) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy path data");
+    }
+    if (data_destroy(pool, request) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy request data");
+    }
+    if (data_destroy(pool, raw_response) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy raw response data");
+    }
+
+    return RESULT_OK;
+}
+
+// HTTP server-sent events
+
+// Deltas live at choices[i].delta.content (streamed) or
+// choices[i].message.content (whole reply). Bit d of objects/keys records the
+// container kind and key match at depth d.
+static result_t http_sse_begin_object(void* ctx) {
+    http_sse_t* sse = (http_sse_t*)ctx;
+    sse->depth++;
+    if (sse->depth < 64) {
+        sse->objects |= 1ULL << sse->depth;
+        sse->keys &= ~(1ULL << sse->depth);
+    }
+    return RESULT_OK;
+}
+
+static result_t http_sse_begin_array(void* ctx) {
+    http_sse_t* sse = (http_sse_t*)ctx;
+    sse->depth++;
+    if (sse->depth < 64) {
+        sse->objects &= ~(1ULL << sse->depth);
+        sse->keys &= ~(1ULL << sse->depth);
+    }
+    return RESULT_OK;
+}
+
+static result_t http_sse_end(void* ctx) {
+    http_sse_t* sse = (http_sse_t*)ctx;
+    sse->depth--;
+    return RESULT_OK;
+}
+
+static result_t http_sse_key(void* ctx, const data_view_t* key) {
+    http_sse_t* sse = (http_sse_t*)ctx;
+    uint64_t match = 0;
+    if (sse->depth == 1) {
+        match = data_view_equal_str(key, "choices");
+    } else if (sse->depth == 3) {
+        match = data_view_equal_str(key, "delta") || data_view_equal_str(key, "message");
+    } else if (sse->depth == 4) {
+        match = data_view_equal_str(key, "content");
+    }
+    if (sse->depth < 64) {
+        sse->keys = match ? sse->keys | (1ULL << sse->depth) : sse->keys & ~(1ULL << sse->depth);
+    }
+    return RESULT_OK;
+}
+
+static result_t http_sse_string(void* ctx, const data_view_t* value) {
+    http_sse_t* sse = (http_sse_t*)ctx;
+    if (sse->depth != 4 || (sse->objects & 0x1E) != 0x1A || (sse->keys & 0x1A) != 0x1A) {
+        return RESULT_OK;
+    }
+    if (data_append_view(sse->pool, &sse->content, value) != RESULT_OK) {
+        RETURN_ERR("Failed to append content delta");
+    }
+    if (sse->delta && sse->delta(sse->ctx, value) != RESULT_OK) {
+        RETURN_ERR("Content delta handler failed");
+    }
+    return RESULT_OK;
+}
+
+static const object_sax_handler_t http_sse_handler = {
+    http_sse_begin_object,
+    http_sse_end,
+    http_sse_begin_array,
+    http_sse_end,
+    http_sse_key,
+    http_sse_string,
+    NULL,
+};
+
+result_t http_sse_init(pool_t* pool, http_sse_t* sse, result_t (*delta)(void* ctx, const data_view_t* delta), void* ctx) {
+    object_sax_init(&sse->sax, &http_sse_handler, sse);
+    sse->pool = pool;
+    sse->delta = delta;
+    sse->ctx = ctx;
+    if (data_create(pool, &sse->line) != RESULT_OK) {
+        RETURN_ERR("Failed to create SSE line buffer");
+    }
+    if (data_create(pool, &sse->content) != RESULT_OK) {
+        if (data_destroy(pool, sse->line) != RESULT_OK) {
+            RETURN_ERR("Failed to destroy SSE line buffer");
+        }
+        RETURN_ERR("Failed to create SSE content buffer");
+    }
+    http_sse_reset(sse);
+    return RESULT_OK;
+}
+
+// Keeps the buffers, so one decoder can be reused across requests.
+void http_sse_reset(http_sse_t* sse) {
+    object_sax_reset(&sse->sax);
+    sse->line->size = 0;
+    sse->content->size = 0;
+    sse->mode = 0;
+    sse->lines = 0;
+    sse->done = 0;
+    sse->depth = 0;
+    sse->objects = 0;
+    sse->keys = 0;
+}
+
+// Whether a data value is the "[DONE]" sentinel, or could still become it
+// while the line is incomplete. SSE allows one space after the colon.
+static uint64_t http_sse_sentinel(const data_t* line, uint64_t complete) {
+    const char* p = line->data;
+    uint64_t size = line->size;
+    if (size > 0 && p[0] == ' ') {
+        p++;
+        size--;
+    }
+    if (!complete) {
+        return size <= 7 && memcmp(p, "[DONE]\r", size) == 0;
+    }
+    if (size > 0 && p[size - 1] == '\r') {
+        size--;
+    }
+    return size == 6 && memcmp(p, "[DONE]", 6) == 0;
+}
+
+static result_t http_sse_json(pool_t* pool, http_sse_t* sse, const char* p, const char* end) {
+    data_view_t view = {p, (uint64_t)(end - p)};
+    if (object_sax_feed(pool, &sse->sax, &view) != RESULT_OK) {
+        RETURN_ERR("Malformed JSON in SSE data");
+    }
+    return RESULT_OK;
+}
+
+// Modes: 0 field name, 1 JSON data, 2 ignored line, 3 data that may still be
+// the sentinel (held in line). Data lines go to the parser as they arrive, so
+// a delta is reported without waiting for the end of its event.
+result_t http_sse_feed(pool_t* pool, http_sse_t* sse, const data_view_t* chunk) {
+    if (!sse || !chunk) {
+        RETURN_ERR("Invalid arguments: decoder and chunk are required");
+    }
+    sse->pool = pool;
+    const char* p = chunk->data;
+    const char* end = p + chunk->size;
+    while (p < end && !sse->done) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        const char* stop = nl ? nl : end;
+        if (sse->mode == 0) {
+            const char* colon = memchr(p, ':', (size_t)(stop - p));
+            data_view_t view = {p, (uint64_t)((colon ? colon : stop) - p)};
+            if (data_append_view(pool, &sse->line, &view) != RESULT_OK) {
+                RETURN_ERR("Failed to buffer SSE field name");
+            }
+            if (!colon && !nl) {
+                p = end;
+                continue;
+            }
+            data_view_t field = data_view_data(sse->line);
+            if (!colon && field.size > 0 && field.data[field.size - 1] == '\r') {
+                field.size--;
+            }
+            sse->line->size = 0;
+            p = colon ? colon + 1 : nl + 1;
+            if (!colon && field.size == 0) {
+                // A blank line ends the event. Empty data lines leave the
+                // parser waiting for its first value, and carry no payload.
+                if (sse->lines > 0) {
+                    sse->lines = 0;
+                    if ((sse->sax.state != 0 || sse->sax.token != 0) && object_sax_finish(pool, &sse->sax) != RESULT_OK) {
+                        RETURN_ERR("Incomplete JSON in SSE event");
+                    }
+                    object_sax_reset(&sse->sax);
+                }
+            } else if (data_view_equal_str(&field, "data")) {
+                // Data lines of one event join with a newline, which JSON
+                // reads as whitespace
+                if (sse->lines > 0 && http_sse_json(pool, sse, "\n", "\n" + 1) != RESULT_OK) {
+                    RETURN_ERR("Failed to join SSE data lines");
+                }
+                sse->lines++;
+                sse->mode = colon ? 3 : 0;
+            } else {
+                sse->mode = colon ? 2 : 0;
+            }
+        } else if (sse->mode == 3) {
+            uint64_t room = 8 - sse->line->size;
+            const char* take = (uint64_t)(stop - p) > room ? p + room : stop;
+            data_view_t view = {p, (uint64_t)(take - p)};
+            if (data_append_view(pool, &sse->line, &view) != RESULT_OK) {
+                RETURN_ERR("Failed to buffer SSE data");
+            }
+            p = take;
+            uint64_t complete = nl && p == nl;
+            if (complete && http_sse_sentinel(sse->line, 1)) {
+                sse->done = 1;
+                sse->line->size = 0;
+                break;
+            }
+            if (!complete && p == end && http_sse_sentinel(sse->line, 0)) {
+                continue;
+            }
+            if (http_sse_json(pool, sse, sse->line->data, sse->line->data + sse->line->size) != RESULT_OK) {
+                RETURN_ERR("Failed to parse SSE data");
+            }
+            sse->line->size = 0;
+            sse->mode = 1;
+        } else {
+            if (sse->mode == 1 && http_sse_json(pool, sse, p, stop) != RESULT_OK) {
+                RETURN_ERR("Failed to parse SSE data");
+            }
+            if (nl) {
+                sse->mode = 0;
+            }
+            p = nl ? nl + 1 : end;
         }
-        if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after content length header failure");
+    }
+    return RESULT_OK;
+}
+
+result_t http_sse_destroy(pool_t* pool, http_sse_t* sse) {
+    if (!sse) {
+        RETURN_ERR("Invalid SSE decoder");
+    }
+    if (object_sax_destroy(pool, &sse->sax) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy SSE JSON parser");
+    }
+    if (sse->line && data_destroy(pool, sse->line) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy SSE line buffer");
+    }
+    sse->line = NULL;
+    if (sse->content && data_destroy(pool, sse->content) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy SSE content buffer");
+    }
+    sse->content = NULL;
+    return RESULT_OK;
+}
+
+// Helper function to tell whether response headers declare a chunked body
+static uint64_t response_is_chunked(const char* head, uint64_t size) {
+    const char* p = head;
+    const char* end = head + size;
+    while (p < end) {
+        const char* eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) {
+            eol = end;
+        }
+        if (eol - p > 18 && strncasecmp(p, "transfer-encoding:", 18) == 0) {
+            for (const char* q = p + 18; q + 7 <= eol; q++) {
+                if (strncasecmp(q, "chunked", 7) == 0) {
+                    return 1;
+                }
+            }
         }
-        RETURN_ERR("Failed to add Content-Length header");
+        p = eol + 1;
     }
+    return 0;
+}
 
-    // Add Connection header and end headers
-    if (data_append_str(pool, &request, "Connection: close\r\n\r\n") != RESULT_OK) {
-        if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after connection header failure");
+// Helper function to decode a chunked body as it arrives. States: 0 size line,
+// 1 chunk extension, 2 chunk data, 3 line end after data, 4 last chunk seen.
+static result_t decode_chunked_body(pool_t* pool, http_sse_t* sse, uint64_t* state, uint64_t* left, const char* p, const char* end) {
+    while (p < end && *state != 4 && !sse->done) {
+        if (*state == 2) {
+            uint64_t size = (uint64_t)(end - p) < *left ? (uint64_t)(end - p) : *left;
+            data_view_t view = {p, size};
+            if (http_sse_feed(pool, sse, &view) != RESULT_OK) {
+                RETURN_ERR("Failed to decode event stream chunk");
+            }
+            p += size;
+            *left -= size;
+            if (*left == 0) {
+                *state = 3;
+            }
+            continue;
         }
-        if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after connection header failure");
+        char c = *p++;
+        if (*state == 0 && isxdigit((unsigned char)c)) {
+            if (*left >> 60) {
+                RETURN_ERR("Chunk size too large");
+            }
+            *left = *left * 16 + (uint64_t)(isdigit((unsigned char)c) ? c - '0' : (c | 0x20) - 'a' + 10);
+        } else if (*state == 0 && c == ';') {
+            *state = 1;
+        } else if ((*state == 0 || *state == 1) && c == '\n') {
+            *state = *left ? 2 : 4;
+        } else if (*state == 3 && c == '\n') {
+            *state = 0;
+        } else if (*state != 1 && c != '\r') {
+            RETURN_ERR("Malformed chunked transfer encoding");
         }
-        if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after connection header failure");
+    }
+    return RESULT_OK;
+}
+
+// Helper function to receive a streamed response, handing body bytes to the
+// decoder as soon as each recv returns
+static result_t receive_sse_response(pool_t* pool, int sock_fd, http_sse_t* sse) {
+    data_t* head = NULL;
+    if (data_create(pool, &head) != RESULT_OK) {
+        RETURN_ERR("Failed to create response header data");
+    }
+
+    char buffer[4096];
+    ssize_t bytes_read = 0;
+    int64_t body_start = -1;
+    uint64_t chunked = 0;
+    uint64_t state = 0;
+    uint64_t left = 0;
+    while (!sse->done && state != 4 && (bytes_read = recv(sock_fd, buffer, sizeof(buffer), 0)) > 0) {
+        const char* p = buffer;
+        const char* end = buffer + bytes_read;
+        if (body_start < 0) {
+            data_view_t view = {buffer, (uint64_t)bytes_read};
+            if (data_append_view(pool, &head, &view) != RESULT_OK) {
+                if (data_destroy(pool, head) != RESULT_OK) {
+                    RETURN_ERR("Failed to destroy response header data");
+                }
+                RETURN_ERR("Failed to append response header data");
+            }
+            body_start = find_body_start(head);
+            if (body_start < 0) {
+                continue;
+            }
+            if (check_response_status(head) != RESULT_OK) {
+                if (data_destroy(pool, head) != RESULT_OK) {
+                    RETURN_ERR("Failed to destroy response header data");
+                }
+                RETURN_ERR("HTTP response status check failed");
+            }
+            chunked = response_is_chunked(head->data, (uint64_t)body_start);
+            p = head->data + body_start;
+            end = head->data + head->size;
+        }
+        data_view_t body = {p, (uint64_t)(end - p)};
+        if ((chunked ? decode_chunked_body(pool, sse, &state, &left, p, end) : http_sse_feed(pool, sse, &body)) != RESULT_OK) {
+            if (data_destroy(pool, head) != RESULT_OK) {
+                RETURN_ERR("Failed to destroy response header data");
+            }
+            RETURN_ERR("Failed to decode event stream");
         }
-        RETURN_ERR("Failed to add Connection header");
     }
 
-    // Add body
-    if (data_append_data(pool, &request, body) != RESULT_OK) {
+    if (data_destroy(pool, head) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy response header data");
+    }
+    if (bytes_read < 0) {
+        RETURN_ERR("Error reading HTTP response");
+    }
+    if (body_start < 0) {
+        RETURN_ERR("Incomplete HTTP response headers");
+    }
+
+    return RESULT_OK;
+}
+
+// Streams a chat-completions style response into sse, which is reset first.
+// Returns once the stream sends "[DONE]" or the server closes the connection.
+result_t http_post_sse(pool_t* pool, const data_t* url, const data_t* content_type, const data_t* body, http_sse_t* sse) {
+    data_t* host = NULL;
+    data_t* path = NULL;
+    data_t* request = NULL;
+    uint16_t port;
+    int sock_fd;
+
+    if (!sse || !sse->line || !sse->content) {
+        RETURN_ERR("Invalid SSE decoder");
+    }
+    http_sse_reset(sse);
+
+    // Extract URL components
+    if (extract_url_components(url, &host, &port, &path, pool) != RESULT_OK) {
+        RETURN_ERR("Failed to extract URL components");
+    }
+
+    // Create HTTP POST request
+    if (build_post_request(pool, host, path, content_type, "text/event-stream", body, &request) != RESULT_OK) {
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after body append failure");
+            RETURN_ERR("Failed to destroy host data after request build failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after body append failure");
-        }
-        if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after body append failure");
+            RETURN_ERR("Failed to destroy path data after request build failure");
         }
-        RETURN_ERR("Failed to add request body");
+        RETURN_ERR("Failed to build HTTP POST request");
     }
 
     // Create connection
@@ -511,37 +867,20 @@ result_t http_post(pool_t* pool, const data_t* url, const data_t* content_type,
         RETURN_ERR("Failed to create connection");
     }
 
-    // Send request and receive response
-    if (send_http_request(pool, sock_fd, request, &raw_response) != RESULT_OK) {
+    // Send request and stream the response into the decoder
+    if (send(sock_fd, request->data, request->size, 0) != (ssize_t)request->size ||
+        receive_sse_response(pool, sock_fd, sse) != RESULT_OK) {
         close(sock_fd);
         if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after request send failure");
+            RETURN_ERR("Failed to destroy host data after stream failure");
         }
         if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after request send failure");
+            RETURN_ERR("Failed to destroy path data after stream failure");
         }
         if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after request send failure");
+            RETURN_ERR("Failed to destroy request data after stream failure");
         }
-        RETURN_ERR("Failed to send HTTP request and receive response");
-    }
-
-    // Extract response body
-    if (extract_response_body(pool, raw_response, response) != RESULT_OK) {
-        close(sock_fd);
-        if (data_destroy(pool, host) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy host data after body extraction failure");
-        }
-        if (data_destroy(pool, path) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy path data after body extraction failure");
-        }
-        if (data_destroy(pool, request) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy request data after body extraction failure");
-        }
-        if (data_destroy(pool, raw_response) != RESULT_OK) {
-            RETURN_ERR("Failed to destroy raw response data after body extraction failure");
-        }
-        RETURN_ERR("Failed to extract response body");
+        RETURN_ERR("Failed to stream HTTP response");
     }
 
     // Clean up all resources
@@ -555,9 +894,6 @@ result_t http_post(pool_t* pool, const data_t* url, const data_t* content_type,
     if (data_destroy(pool, request) != RESULT_OK) {
         RETURN_ERR("Failed to destroy request data");
     }
-    if (data_destroy(pool, raw_response) != RESULT_OK) {
-        RETURN_ERR("Failed to destroy raw response data");
-    }
 
     return RESULT_OK;
 }
@@ -1,6 +1,10 @@
 #ifndef LKJLIB_H
 #define LKJLIB_H
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 // Standard Libraries
 #include <arpa/inet.h>
 #include <ctype.h>
@@ -8,18 +12,25 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <libgen.h>
+#include <math.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 // Constants
 #define POOL_SIZE_BIAS 16
@@ -30,6 +41,28 @@
 #define POOL_data65536_MAXCOUNT (16 * POOL_SIZE_BIAS)
 #define POOL_data1048576_MAXCOUNT (1 * POOL_SIZE_BIAS)
 #define POOL_OBJECT_MAXCOUNT (4096 * POOL_SIZE_BIAS)
+#define POOL_HUGE_MAXCOUNT (64 * POOL_SIZE_BIAS)
+#define POOL_CLASS_MAXCOUNT 16
+#define POOL_SLAB_SIZE 65536
+#define POOL_CACHE_SIZE 32
+#define POOL_CACHE_MAXCOUNT 64
+#define POOL_OBJECT_CHUNK_SIZE 128
+#define POOL_INTERN_MINCOUNT 256
+#define DATA_ROPE_SEGMENT_MINSIZE 256
+#define DATA_ROPE_SEGMENT_MAXSIZE 65536
+#define DATA_ROPE_IOV_MAXCOUNT 64
+#define DATA_NUMBER_MAXSIZE 32
+#define DATA_NUMBER_LITERAL_MAXSIZE 512
+#define OBJECT_INDEX_MINCOUNT 16
+#define OBJECT_TAPE_DEPTH_MAXCOUNT 1024
+#define OBJECT_TAPE_WINDOW_SIZE 65536
+#define OBJECT_SAX_DEPTH_MAXCOUNT 1024
+#define OBJECT_TAPE_PAYLOAD_MASK 0x00FFFFFFFFFFFFFFULL
+#ifdef POOL_DEBUG
+#define POOL_CANARY_SIZE 16
+#else
+#define POOL_CANARY_SIZE 0
+#endif
 
 // Types
 typedef enum result_t {
@@ -40,36 +73,146 @@ typedef struct data_t {
     char* data;
     uint64_t capacity;
     uint64_t size;
+    uint64_t hash;
 } data_t;
+typedef struct data_view_t {
+    const char* data;
+    uint64_t size;
+} data_view_t;
 typedef struct object_t {
     data_t* data;
     struct object_t* child;
     struct object_t* next;
+    data_t* index;
 } object_t;
+typedef struct object_tape_t {
+    data_t* entries;
+    data_t* strings;
+} object_tape_t;
+typedef struct object_sax_handler_t {
+    result_t (*begin_object)(void* ctx);
+    result_t (*end_object)(void* ctx);
+    result_t (*begin_array)(void* ctx);
+    result_t (*end_array)(void* ctx);
+    result_t (*key)(void* ctx, const data_view_t* key);
+    result_t (*string)(void* ctx, const data_view_t* value);
+    result_t (*primitive)(void* ctx, const data_view_t* value);
+} object_sax_handler_t;
+typedef struct object_sax_t {
+    const object_sax_handler_t* handler;
+    void* ctx;
+    data_t* raw;
+    data_t* text;
+    uint64_t state;
+    uint64_t token;
+    uint64_t escape;
+    uint64_t depth;
+    uint64_t stack[OBJECT_SAX_DEPTH_MAXCOUNT / 64];
+} object_sax_t;
+typedef struct http_sse_t {
+    object_sax_t sax;
+    struct pool_t* pool;
+    data_t* line;
+    data_t* content;
+    result_t (*delta)(void* ctx, const data_view_t* delta);
+    void* ctx;
+    uint64_t mode;
+    uint64_t lines;
+    uint64_t done;
+    uint64_t depth;
+    uint64_t objects;
+    uint64_t keys;
+} http_sse_t;
+typedef struct data_rope_t {
+    object_t* head;
+    object_t* tail;
+    uint64_t size;
+} data_rope_t;
+typedef struct pool_stats_t {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t used;
+    uint64_t high_water;
+    uint64_t failed;
+} pool_stats_t;
+typedef struct pool_debug_t {
+    const char* file;
+    uint64_t line;
+    uint64_t state;
+} pool_debug_t;
+typedef struct pool_class_t {
+    pthread_mutex_t lock;
+    pool_stats_t stats;
+    pool_debug_t* debug;
+    uint64_t capacity;
+    uint64_t maxcount;
+    uint64_t count;
+    uint64_t freelist_count;
+    data_t* data;
+    data_t** freelist_data;
+    char* slot_data;
+} pool_class_t;
+typedef struct pool_config_t {
+    uint64_t class_count;
+    uint64_t class_capacity[POOL_CLASS_MAXCOUNT];
+    uint64_t class_maxcount[POOL_CLASS_MAXCOUNT];
+    uint64_t object_maxcount;
+    uint64_t huge_maxcount;
+    uint64_t concurrent;
+    uint64_t intern;
+} pool_config_t;
+typedef struct pool_object_slab_t {
+    object_t* next;
+    object_t* end;
+} pool_object_slab_t;
+typedef struct pool_cache_t {
+    struct pool_t* pool;
+    uint64_t active;
+    uint64_t data_count[POOL_CLASS_MAXCOUNT];
+    data_t* data[POOL_CLASS_MAXCOUNT][POOL_CACHE_SIZE];
+    uint64_t object_count;
+    object_t* object[POOL_CACHE_SIZE];
+} pool_cache_t;
 typedef struct pool_t {
-    uint64_t data16_freelist_count;
-    uint64_t data256_freelist_count;
-    uint64_t data4096_freelist_count;
-    uint64_t data65536_freelist_count;
-    uint64_t data1048576_freelist_count;
-    data_t data16[POOL_data16_MAXCOUNT];
-    data_t data256[POOL_data256_MAXCOUNT];
-    data_t data4096[POOL_data4096_MAXCOUNT];
-    data_t data65536[POOL_data65536_MAXCOUNT];
-    data_t data1048576[POOL_data1048576_MAXCOUNT];
-    data_t* data16_freelist_data[POOL_data16_MAXCOUNT];
-    data_t* data256_freelist_data[POOL_data256_MAXCOUNT];
-    data_t* data4096_freelist_data[POOL_data4096_MAXCOUNT];
-    data_t* data65536_freelist_data[POOL_data65536_MAXCOUNT];
-    data_t* data1048576_freelist_data[POOL_data1048576_MAXCOUNT];
-    char data16_data[POOL_data16_MAXCOUNT * 16];
-    char data256_data[POOL_data256_MAXCOUNT * 256];
-    char data4096_data[POOL_data4096_MAXCOUNT * 4096];
-    char data65536_data[POOL_data65536_MAXCOUNT * 65536];
-    char data1048576_data[POOL_data1048576_MAXCOUNT * 1048576];
-    object_t object_data[POOL_OBJECT_MAXCOUNT];
-    object_t* object_freelist_data[POOL_OBJECT_MAXCOUNT];
+    uint64_t concurrent;
+    uint64_t arena;
+    uint64_t arena_used;
+    uint64_t arena_committed;
+    char* region;
+    uint64_t region_size;
+    uint64_t page_size;
+    uint64_t class_count;
+    uint8_t class_lookup[65];
+    pool_class_t classes[POOL_CLASS_MAXCOUNT];
+    pthread_mutex_t object_lock;
+    pool_stats_t object_stats;
+    pool_debug_t* object_debug;
+    uint64_t object_maxcount;
+    object_t* object_data;
+    object_t** object_freelist_data;
+    uint64_t object_count;
     uint64_t object_freelist_count;
+    uint64_t* object_chunk_live;
+    uint64_t* object_chunk_freelist_data;
+    uint64_t object_chunk_freelist_count;
+    pool_object_slab_t object_tail;
+    pthread_mutex_t huge_lock;
+    pool_stats_t huge_stats;
+    pool_debug_t* huge_debug;
+    uint64_t huge_maxcount;
+    data_t* huge_data;
+    data_t** huge_freelist_data;
+    uint64_t huge_count;
+    uint64_t huge_freelist_count;
+    pthread_key_t cache_key;
+    pthread_mutex_t cache_lock;
+    pool_cache_t* caches;
+    uint64_t cache_count;
+    pthread_mutex_t intern_lock;
+    uint64_t intern;
+    data_t* intern_table;
+    uint64_t intern_slots;
+    uint64_t intern_count;
 } pool_t;
 
 // Macros
@@ -111,7 +254,11 @@ typedef struct pool_t {
     }
 
 // Pool
-__attribute__((warn_unused_result)) result_t pool_init(pool_t* pool);
+__attribute__((warn_unused_result)) result_t pool_config_default(pool_config_t* config);
+__attribute__((warn_unused_result)) result_t pool_init(pool_t* pool, const pool_config_t* config);
+__attribute__((warn_unused_result)) result_t pool_arena_init(pool_t* pool, uint64_t size);
+__attribute__((warn_unused_result)) result_t pool_reset(pool_t* pool);
+__attribute__((warn_unused_result)) result_t pool_destroy(pool_t* pool);
 __attribute__((warn_unused_result)) result_t pool_data16_alloc(pool_t* pool, data_t** data);
 __attribute__((warn_unused_result)) result_t pool_data256_alloc(pool_t* pool, data_t** data);
 __attribute__((warn_unused_result)) result_t pool_data4096_alloc(pool_t* pool, data_t** data);
@@ -120,47 +267,128 @@ __attribute__((warn_unused_result)) result_t pool_data1048576_alloc(pool_t* pool
 __attribute__((warn_unused_result)) result_t pool_data_alloc(pool_t* pool, data_t** data, uint64_t capacity);
 __attribute__((warn_unused_result)) result_t pool_data_free(pool_t* pool, data_t* data);
 __attribute__((warn_unused_result)) result_t pool_data_realloc(pool_t* pool, data_t** data, uint64_t capacity);
+__attribute__((warn_unused_result)) result_t pool_intern(pool_t* pool, data_t** data, const data_view_t* view);
 __attribute__((warn_unused_result)) result_t pool_object_alloc(pool_t* pool, object_t** obj);
 __attribute__((warn_unused_result)) result_t pool_object_free(pool_t* pool, object_t* obj);
+__attribute__((warn_unused_result)) result_t pool_object_slab_alloc(pool_t* pool, pool_object_slab_t* slab, object_t** obj);
+__attribute__((warn_unused_result)) result_t pool_object_slab_close(pool_t* pool, pool_object_slab_t* slab);
+__attribute__((warn_unused_result)) result_t pool_stats_todata_json(pool_t* pool, data_t** dst);
+void pool_debug_site(const char* file, uint64_t line);
+#ifdef POOL_DEBUG
+#define pool_data_alloc(pool, data, capacity) (pool_debug_site(__FILE__, __LINE__), pool_data_alloc(pool, data, capacity))
+#define pool_data_realloc(pool, data, capacity) (pool_debug_site(__FILE__, __LINE__), pool_data_realloc(pool, data, capacity))
+#define pool_object_alloc(pool, obj) (pool_debug_site(__FILE__, __LINE__), pool_object_alloc(pool, obj))
+#define pool_object_slab_alloc(pool, slab, obj) (pool_debug_site(__FILE__, __LINE__), pool_object_slab_alloc(pool, slab, obj))
+#endif
 
 // data
 __attribute__((warn_unused_result)) result_t data_create(pool_t* pool, data_t** data);
 __attribute__((warn_unused_result)) result_t data_create_data(pool_t* pool, data_t** data1, const data_t* data2);
 __attribute__((warn_unused_result)) result_t data_create_str(pool_t* pool, data_t** data, const char* str);
+__attribute__((warn_unused_result)) result_t data_intern_data(pool_t* pool, data_t** data1, const data_t* data2);
+__attribute__((warn_unused_result)) result_t data_intern_str(pool_t* pool, data_t** data, const char* str);
+__attribute__((warn_unused_result)) result_t data_intern_view(pool_t* pool, data_t** data, const data_view_t* view);
 __attribute__((warn_unused_result)) result_t data_destroy(pool_t* pool, data_t* data);
 __attribute__((warn_unused_result)) result_t data_clean(pool_t* pool, data_t** data);
+__attribute__((warn_unused_result)) result_t data_reserve(pool_t* pool, data_t** data, uint64_t size);
 __attribute__((warn_unused_result)) result_t data_copy_data(pool_t* pool, data_t** data1, const data_t* data2);
 __attribute__((warn_unused_result)) result_t data_copy_str(pool_t* pool, data_t** data, const char* str);
 __attribute__((warn_unused_result)) result_t data_append_data(pool_t* pool, data_t** data1, const data_t* data2);
 __attribute__((warn_unused_result)) result_t data_append_str(pool_t* pool, data_t** data, const char* str);
 __attribute__((warn_unused_result)) result_t data_append_char(pool_t* pool, data_t** data, char c);
+__attribute__((warn_unused_result)) result_t data_append_escape_json(pool_t* pool, data_t** dst, const data_t* src);
 __attribute__((warn_unused_result)) result_t data_escape_json(pool_t* pool, data_t** data);
+__attribute__((warn_unused_result)) result_t data_append_unescape_json(pool_t* pool, data_t** dst, const char* src, uint64_t size);
 __attribute__((warn_unused_result)) result_t data_unescape_json(pool_t* pool, data_t** data);
+__attribute__((warn_unused_result)) result_t data_append_base64(pool_t* pool, data_t** dst, const data_t* src);
+__attribute__((warn_unused_result)) result_t data_decode_base64(pool_t* pool, data_t** dst, const data_t* src);
+__attribute__((warn_unused_result)) result_t data_append_hex(pool_t* pool, data_t** dst, const data_t* src);
+__attribute__((warn_unused_result)) result_t data_decode_hex(pool_t* pool, data_t** dst, const data_t* src);
 __attribute__((warn_unused_result)) result_t data_toint(const data_t* data, int64_t* dst);
+__attribute__((warn_unused_result)) result_t data_todouble(const data_t* data, double* dst);
+__attribute__((warn_unused_result)) result_t data_append_int(pool_t* pool, data_t** data, int64_t value);
+__attribute__((warn_unused_result)) result_t data_append_double(pool_t* pool, data_t** data, double value);
 uint64_t data_equal_data(const data_t* data1, const data_t* data2);
 uint64_t data_equal_str(const data_t* data, const char* str);
 int64_t data_find_data(const data_t* data1, const data_t* data2, uint64_t index);
 int64_t data_find_str(const data_t* data, const char* str, uint64_t index);
 int64_t data_find_char(const data_t* data, char c, uint64_t index);
+int64_t data_find_any(const data_t* data, const char* set, uint64_t index);
+uint64_t data_utf8_valid(const data_t* data);
+uint64_t data_utf8_count(const data_t* data);
+const char* data_scan_any(const char* p, const char* end, const char* set);
+const char* data_skip_any(const char* p, const char* end, const char* set);
+void data_rope_init(data_rope_t* rope);
+__attribute__((warn_unused_result)) result_t data_rope_destroy(pool_t* pool, data_rope_t* rope);
+__attribute__((warn_unused_result)) result_t data_rope_reserve(pool_t* pool, data_rope_t* rope, uint64_t size);
+__attribute__((warn_unused_result)) result_t data_rope_append_data(pool_t* pool, data_rope_t* rope, const data_t* data);
+__attribute__((warn_unused_result)) result_t data_rope_append_str(pool_t* pool, data_rope_t* rope, const char* str);
+__attribute__((warn_unused_result)) result_t data_rope_append_char(pool_t* pool, data_rope_t* rope, char c);
+__attribute__((warn_unused_result)) result_t data_rope_append_int(pool_t* pool, data_rope_t* rope, int64_t value);
+__attribute__((warn_unused_result)) result_t data_rope_append_double(pool_t* pool, data_rope_t* rope, double value);
+__attribute__((warn_unused_result)) result_t data_rope_append_view(pool_t* pool, data_rope_t* rope, const data_view_t* view);
+__attribute__((warn_unused_result)) result_t data_rope_append_escape_json(pool_t* pool, data_rope_t* rope, const data_t* src);
+__attribute__((warn_unused_result)) result_t data_rope_flatten(pool_t* pool, data_t** dst, const data_rope_t* rope);
+__attribute__((warn_unused_result)) result_t data_rope_write(int fd, const data_rope_t* rope);
+data_view_t data_view_data(const data_t* data);
+data_view_t data_view_str(const char* str);
+__attribute__((warn_unused_result)) result_t data_view_slice(data_view_t* dst, const data_view_t* src, uint64_t index, uint64_t size);
+__attribute__((warn_unused_result)) result_t data_create_view(pool_t* pool, data_t** data, const data_view_t* view);
+__attribute__((warn_unused_result)) result_t data_copy_view(pool_t* pool, data_t** data, const data_view_t* view);
+__attribute__((warn_unused_result)) result_t data_append_view(pool_t* pool, data_t** data, const data_view_t* view);
+__attribute__((warn_unused_result)) result_t data_view_toint(const data_view_t* view, int64_t* dst);
+__attribute__((warn_unused_result)) result_t data_view_todouble(const data_view_t* view, double* dst);
+uint64_t data_view_utf8_valid(const data_view_t* view);
+uint64_t data_view_utf8_count(const data_view_t* view);
+uint64_t data_view_hash(const data_view_t* view);
+uint64_t data_view_equal_view(const data_view_t* view1, const data_view_t* view2);
+uint64_t data_view_equal_str(const data_view_t* view, const char* str);
+int64_t data_view_find_view(const data_view_t* view1, const data_view_t* view2, uint64_t index);
+int64_t data_view_find_str(const data_view_t* view, const char* str, uint64_t index);
+int64_t data_view_find_char(const data_view_t* view, char c, uint64_t index);
 
 // File
 __attribute__((warn_unused_result)) result_t file_read(pool_t* pool, const char* path, data_t** data);
 __attribute__((warn_unused_result)) result_t file_write(const char* path, const data_t* data);
+__attribute__((warn_unused_result)) result_t file_write_rope(const char* path, const data_rope_t* rope);
 
 // Object
 __attribute__((warn_unused_result)) result_t object_create(pool_t* pool, object_t** dst);
 __attribute__((warn_unused_result)) result_t object_destroy(pool_t* pool, object_t* object);
 __attribute__((warn_unused_result)) result_t object_parse_json(pool_t* pool, object_t** dst, const data_t* src);
 __attribute__((warn_unused_result)) result_t object_todata_json(pool_t* pool, data_t** dst, const object_t* src);
+__attribute__((warn_unused_result)) result_t object_torope_json(pool_t* pool, data_rope_t* dst, const object_t* src);
 __attribute__((warn_unused_result)) result_t object_parse_xml(pool_t* pool, object_t** dst, const data_t* src);
 __attribute__((warn_unused_result)) result_t object_todata_xml(pool_t* pool, data_t** dst, const object_t* src);
+__attribute__((warn_unused_result)) result_t object_torope_xml(pool_t* pool, data_rope_t* dst, const object_t* src);
 __attribute__((warn_unused_result)) result_t object_provide_data(object_t** dst, const object_t* object, const data_t* path);
 __attribute__((warn_unused_result)) result_t object_provide_str(object_t** dst, const object_t* object, const char* path);
 __attribute__((warn_unused_result)) result_t object_set_data(pool_t* pool, object_t* object, const data_t* path, const data_t* data);
 __attribute__((warn_unused_result)) result_t object_set_str(pool_t* pool, object_t* object, const char* path, const char* str);
+__attribute__((warn_unused_result)) result_t object_index_invalidate(object_t* object);
+__attribute__((warn_unused_result)) result_t object_tape_parse_json(pool_t* pool, object_tape_t* tape, const data_t* src);
+__attribute__((warn_unused_result)) result_t object_tape_destroy(pool_t* pool, object_tape_t* tape);
+__attribute__((warn_unused_result)) result_t object_tape_provide_str(uint64_t* dst, const object_tape_t* tape, const char* path);
+__attribute__((warn_unused_result)) result_t object_tape_toobject(pool_t* pool, object_t** dst, const object_tape_t* tape, uint64_t index);
+char object_tape_type(const object_tape_t* tape, uint64_t index);
+uint64_t object_tape_next(const object_tape_t* tape, uint64_t index);
+data_view_t object_tape_view(const object_tape_t* tape, uint64_t index);
+__attribute__((warn_unused_result)) result_t object_cursor_provide_str(data_view_t* dst, const data_view_t* src, const char* path);
+__attribute__((warn_unused_result)) result_t object_cursor_todata(pool_t* pool, data_t** dst, const data_view_t* src);
+__attribute__((warn_unused_result)) result_t object_cursor_toobject(pool_t* pool, object_t** dst, const data_view_t* src);
+void object_sax_init(object_sax_t* sax, const object_sax_handler_t* handler, void* ctx);
+void object_sax_reset(object_sax_t* sax);
+__attribute__((warn_unused_result)) result_t object_sax_feed(pool_t* pool, object_sax_t* sax, const data_view_t* chunk);
+__attribute__((warn_unused_result)) result_t object_sax_finish(pool_t* pool, object_sax_t* sax);
+__attribute__((warn_unused_result)) result_t object_sax_destroy(pool_t* pool, object_sax_t* sax);
 
 // HTTP
 __attribute__((warn_unused_result)) result_t http_get(pool_t* pool, const data_t* url, data_t** response);
 __attribute__((warn_unused_result)) result_t http_post(pool_t* pool, const data_t* url, const data_t* content_type, const data_t* body, data_t** response);
+__attribute__((warn_unused_result)) result_t http_post_sse(pool_t* pool, const data_t* url, const data_t* content_type, const data_t* body, http_sse_t* sse);
+__attribute__((warn_unused_result)) result_t http_sse_init(pool_t* pool, http_sse_t* sse, result_t (*delta)(void* ctx, const data_view_t* delta), void* ctx);
+void http_sse_reset(http_sse_t* sse);
+__attribute__((warn_unused_result)) result_t http_sse_feed(pool_t* pool, http_sse_t* sse, const data_view_t* chunk);
+__attribute__((warn_unused_result)) result_t http_sse_destroy(pool_t* pool, http_sse_t* sse);
 
 #endif
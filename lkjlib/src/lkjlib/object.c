@@ -1,73 +1,8 @@
 #include "lkjlib.h"
 
 // Object
-static result_t escape_json_data(pool_t* pool, const data_t* input, data_t** output) {
-    uint64_t cap = (input ? input->size : 0) * 2 + 2;
-    if (pool_data_alloc(pool, output, cap) != RESULT_OK) {
-        RETURN_ERR("Failed to allocate buffer for JSON-escaped string");
-    }
-    (*output)->size = 0;
-    if (!input || input->size == 0)
-        return RESULT_OK;
-    for (uint64_t i = 0; i < input->size; i++) {
-        unsigned char ch = (unsigned char)input->data[i];
-        switch (ch) {
-            case '"':
-                if (data_append_str(pool, output, "\\\"") != RESULT_OK) {
-                    RETURN_ERR("Failed to append escaped quote while escaping JSON string");
-                }
-                break;
-            case '\\':
-                if (data_append_str(pool, output, "\\\\") != RESULT_OK) {
-                    RETURN_ERR("Failed to append escaped backslash while escaping JSON string");
-                }
-                break;
-            case '\b':
-                if (data_append_str(pool, output, "\\b") != RESULT_OK) {
-                    RETURN_ERR("Failed to append \\b while escaping JSON string");
-                }
-                break;
-            case '\f':
-                if (data_append_str(pool, output, "\\f") != RESULT_OK) {
-                    RETURN_ERR("Failed to append \\f while escaping JSON string");
-                }
-                break;
-            case '\n':
-                if (data_append_str(pool, output, "\\n") != RESULT_OK) {
-                    RETURN_ERR("Failed to append \\n while escaping JSON string");
-                }
-                break;
-            case '\r':
-                if (data_append_str(pool, output, "\\r") != RESULT_OK) {
-                    RETURN_ERR("Failed to append \\r while escaping JSON string");
-                }
-                break;
-            case '\t':
-                if (data_append_str(pool, output, "\\t") != RESULT_OK) {
-                    RETURN_ERR("Failed to append \\t while escaping JSON string");
-                }
-                break;
-            default:
-                if (ch < 0x20) {
-                    char buf[7];
-                    snprintf(buf, sizeof(buf), "\\u%04x", ch);
-                    if (data_append_str(pool, output, buf) != RESULT_OK) {
-                        RETURN_ERR("Failed to append Unicode escape while escaping JSON string");
-                    }
-                } else {
-                    if (data_append_char(pool, output, (char)ch) != RESULT_OK) {
-                        RETURN_ERR("Failed to append raw character while escaping JSON string");
-                    }
-                }
-        }
-    }
-    return RESULT_OK;
-}
-
 static const char* skip_ws(const char* p, const char* end) {
-    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
-        p++;
-    return p;
+    return data_skip_any(p, end, " \n\r\t");
 }
 
 static result_t parse_json_data(pool_t* pool, const char** json, const char* end, data_t** out) {
@@ -81,105 +16,66 @@ static result_t parse_json_data(pool_t* pool, const char** json, const char* end
     p++;
     const char* start = p;
     while (p < end) {
-        if (*p == '"')
+        p = data_scan_any(p, end, "\"\\");
+        if (p >= end || *p == '"')
             break;
-        if (*p == '\\' && p + 1 < end) {
-            p += 2;
-            continue;
-        }
-        p++;
+        p += p + 1 < end ? 2 : 1;
     }
     if (p >= end || *p != '"') {
         RETURN_ERR("Unterminated JSON string literal");
     }
     size_t raw_len = (size_t)(p - start);
-    if (pool_data_alloc(pool, out, raw_len + 1) != RESULT_OK) {
-        RETURN_ERR("Failed to allocate buffer for raw JSON string");
+    if (pool_data_alloc(pool, out, raw_len) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate buffer for JSON string");
     }
-    (*out)->size = raw_len;
-    memcpy((*out)->data, start, raw_len);
-    data_t* decoded = NULL;
-    if (pool_data_alloc(pool, &decoded, raw_len + 1) != RESULT_OK) {
-        RETURN_ERR("Failed to allocate buffer for decoded JSON string");
-    }
-    decoded->size = 0;
-    for (size_t i = 0; i < raw_len;) {
-        char c = (*out)->data[i];
-        if (c == '\\' && i + 1 < raw_len) {
-            char e = (*out)->data[i + 1];
-            switch (e) {
-                case '"':
-                    if (data_append_char(pool, &decoded, '"') != RESULT_OK) {
-                        RETURN_ERR("Failed to append double quote while decoding JSON escape");
-                    }
-                    break;
-                case '\\':
-                    if (data_append_char(pool, &decoded, '\\') != RESULT_OK) {
-                        RETURN_ERR("Failed to append backslash while decoding JSON escape");
-                    }
-                    break;
-                case '/':
-                    if (data_append_char(pool, &decoded, '/') != RESULT_OK) {
-                        RETURN_ERR("Failed to append '/' while decoding JSON escape");
-                    }
-                    break;
-                case 'b':
-                    if (data_append_char(pool, &decoded, '\b') != RESULT_OK) {
-                        RETURN_ERR("Failed to append backspace while decoding JSON escape");
-                    }
-                    break;
-                case 'f':
-                    if (data_append_char(pool, &decoded, '\f') != RESULT_OK) {
-                        RETURN_ERR("Failed to append form-feed while decoding JSON escape");
-                    }
-                    break;
-                case 'n':
-                    if (data_append_char(pool, &decoded, '\n') != RESULT_OK) {
-                        RETURN_ERR("Failed to append newline while decoding JSON escape");
-                    }
-                    break;
-                case 'r':
-                    if (data_append_char(pool, &decoded, '\r') != RESULT_OK) {
-                        RETURN_ERR("Failed to append carriage return while decoding JSON escape");
-                    }
-                    break;
-                case 't':
-                    if (data_append_char(pool, &decoded, '\t') != RESULT_OK) {
-                        RETURN_ERR("Failed to append tab while decoding JSON escape");
-                    }
-                    break;
-                default:
-                    if (data_append_char(pool, &decoded, e) != RESULT_OK) {
-                        RETURN_ERR("Invalid escape sequence in JSON string");
-                    }
-                    break;
-            }
-            i += 2;
-        } else {
-            if (data_append_char(pool, &decoded, c) != RESULT_OK) {
-                RETURN_ERR("Failed to append character to decoded JSON string");
-            }
-            i++;
-        }
+    (*out)->size = 0;
+    if (data_append_unescape_json(pool, out, start, raw_len) != RESULT_OK) {
+        RETURN_ERR("Failed to decode JSON string");
     }
-    data_t* tmp = *out;
-    *out = decoded;
-    if (pool_data_free(pool, tmp) != RESULT_OK)
-        RETURN_ERR("Failed to free temporary buffer for raw JSON string");
     *json = p + 1;
     return RESULT_OK;
 }
 
-static result_t parse_json_value_local(pool_t* pool, const char** json, const char* end, object_t** out);
+// Pools created with interning share one copy of each distinct key. Keys
+// without escapes are interned straight from the input.
+static result_t parse_json_key_local(pool_t* pool, const char** json, const char* end, data_t** out) {
+    if (!pool->intern) {
+        return parse_json_data(pool, json, end, out);
+    }
+    const char* start = *json + 1;
+    const char* p = data_scan_any(start, end, "\"\\");
+    if (p < end && *p == '"') {
+        data_view_t view = {start, (uint64_t)(p - start)};
+        if (pool_intern(pool, out, &view) != RESULT_OK) {
+            RETURN_ERR("Failed to intern JSON object key");
+        }
+        *json = p + 1;
+        return RESULT_OK;
+    }
+    data_t* decoded = NULL;
+    if (parse_json_data(pool, json, end, &decoded) != RESULT_OK) {
+        RETURN_ERR("Failed to decode JSON object key");
+    }
+    result_t result = data_intern_data(pool, out, decoded);
+    if (data_destroy(pool, decoded) != RESULT_OK) {
+        RETURN_ERR("Failed to free decoded JSON object key");
+    }
+    if (result != RESULT_OK) {
+        RETURN_ERR("Failed to intern JSON object key");
+    }
+    return RESULT_OK;
+}
+
+static result_t parse_json_value_local(pool_t* pool, pool_object_slab_t* slab, const char** json, const char* end, object_t** out);
 
-static result_t parse_json_array_local(pool_t* pool, const char** json, const char* end, object_t** out) {
+static result_t parse_json_array_local(pool_t* pool, pool_object_slab_t* slab, const char** json, const char* end, object_t** out) {
     const char* p = *json;
     if (p >= end || *p != '[') {
         RETURN_ERR("Expected '[' at start of JSON array");
     }
     p++;
     p = skip_ws(p, end);
-    if (pool_object_alloc(pool, out) != RESULT_OK) {
+    if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
         RETURN_ERR("Failed to allocate array object from pool");
     }
     (*out)->data = NULL;
@@ -193,7 +89,7 @@ static result_t parse_json_array_local(pool_t* pool, const char** json, const ch
     }
     while (p < end) {
         object_t* elem;
-        if (parse_json_value_local(pool, &p, end, &elem) != RESULT_OK) {
+        if (parse_json_value_local(pool, slab, &p, end, &elem) != RESULT_OK) {
             RETURN_ERR("Failed to parse JSON array element");
         }
         if (!first) {
@@ -220,14 +116,14 @@ static result_t parse_json_array_local(pool_t* pool, const char** json, const ch
     return RESULT_OK;
 }
 
-static result_t parse_json_object_local(pool_t* pool, const char** json, const char* end, object_t** out) {
+static result_t parse_json_object_local(pool_t* pool, pool_object_slab_t* slab, const char** json, const char* end, object_t** out) {
     const char* p = *json;
     if (p >= end || *p != '{') {
         RETURN_ERR("Expected '{' at start of JSON object");
     }
     p++;
     p = skip_ws(p, end);
-    if (pool_object_alloc(pool, out) != RESULT_OK) {
+    if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
         RETURN_ERR("Failed to allocate object from pool");
     }
     (*out)->data = NULL;
@@ -245,7 +141,7 @@ static result_t parse_json_object_local(pool_t* pool, const char** json, const c
         if (*p != '"') {
             RETURN_ERR("Expected string key in JSON object");
         }
-        if (parse_json_data(pool, &p, end, &key) != RESULT_OK) {
+        if (parse_json_key_local(pool, &p, end, &key) != RESULT_OK) {
             RETURN_ERR("Failed to parse JSON object key");
         }
         p = skip_ws(p, end);
@@ -254,17 +150,14 @@ static result_t parse_json_object_local(pool_t* pool, const char** json, const c
         }
         p++;
         p = skip_ws(p, end);
-        object_t* val;
-        if (parse_json_value_local(pool, &p, end, &val) != RESULT_OK) {
-            RETURN_ERR("Failed to parse JSON object value");
-        }
         object_t* pair;
-        if (pool_object_alloc(pool, &pair) != RESULT_OK) {
+        if (pool_object_slab_alloc(pool, slab, &pair) != RESULT_OK) {
             RETURN_ERR("Failed to allocate key-value node from pool");
         }
         pair->data = key;
-        pair->child = val;
-        pair->next = NULL;
+        if (parse_json_value_local(pool, slab, &p, end, &pair->child) != RESULT_OK) {
+            RETURN_ERR("Failed to parse JSON object value");
+        }
         if (!first) {
             first = last = pair;
         } else {
@@ -307,13 +200,13 @@ static result_t parse_primitive_local(pool_t* pool, const char** json, const cha
     return RESULT_OK;
 }
 
-static result_t parse_json_value_local(pool_t* pool, const char** json, const char* end, object_t** out) {
+static result_t parse_json_value_local(pool_t* pool, pool_object_slab_t* slab, const char** json, const char* end, object_t** out) {
     const char* p = skip_ws(*json, end);
     if (p >= end) {
         RETURN_ERR("Unexpected end of JSON input");
     }
     if (*p == '"') {
-        if (pool_object_alloc(pool, out) != RESULT_OK) {
+        if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
             RETURN_ERR("Failed to allocate object from pool");
         }
         if (parse_json_data(pool, &p, end, &((*out)->data)) != RESULT_OK) {
@@ -325,12 +218,12 @@ static result_t parse_json_value_local(pool_t* pool, const char** json, const ch
         return RESULT_OK;
     } else if (*p == '{') {
         *json = p;
-        return parse_json_object_local(pool, json, end, out);
+        return parse_json_object_local(pool, slab, json, end, out);
     } else if (*p == '[') {
         *json = p;
-        return parse_json_array_local(pool, json, end, out);
+        return parse_json_array_local(pool, slab, json, end, out);
     } else {
-        if (pool_object_alloc(pool, out) != RESULT_OK) {
+        if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
             RETURN_ERR("Failed to allocate object from pool");
         }
         if (parse_primitive_local(pool, &p, end, &((*out)->data)) != RESULT_OK) {
@@ -350,6 +243,7 @@ result_t object_create(pool_t* pool, object_t** dst) {
     (*dst)->data = NULL;
     (*dst)->child = NULL;
     (*dst)->next = NULL;
+    (*dst)->index = NULL;
     return RESULT_OK;
 }
 
@@ -373,6 +267,12 @@ static result_t object_destroy_recursive(pool_t* pool, object_t* obj) {
         }
         obj->child = NULL;
     }
+    if (obj->index) {
+        if (data_destroy(pool, obj->index) != RESULT_OK) {
+            RETURN_ERR("Failed to destroy object's key index");
+        }
+        obj->index = NULL;
+    }
     if (pool_object_free(pool, obj) != RESULT_OK) {
         RETURN_ERR("Failed to return object to pool");
     }
@@ -389,10 +289,19 @@ result_t object_parse_json(pool_t* pool, object_t** dst, const data_t* src) {
     if (!src || src->size == 0) {
         RETURN_ERR("Empty JSON data");
     }
+    // JSON text is UTF-8; reject malformed bytes before building any nodes
+    if (!data_utf8_valid(src)) {
+        RETURN_ERR("Invalid UTF-8 in JSON data");
+    }
     const char* json = src->data;
     const char* end = src->data + src->size;
     const char* p = skip_ws(json, end);
-    if (parse_json_value_local(pool, &p, end, dst) != RESULT_OK) {
+    pool_object_slab_t slab = {NULL, NULL};
+    result_t result = parse_json_value_local(pool, &slab, &p, end, dst);
+    if (pool_object_slab_close(pool, &slab) != RESULT_OK) {
+        RETURN_ERR("Failed to close object slab");
+    }
+    if (result != RESULT_OK) {
         RETURN_ERR("Failed to parse JSON document");
     }
     return RESULT_OK;
@@ -432,64 +341,54 @@ static int32_t is_json_primitive_local(const data_t* s) {
     return i == n;
 }
 
-static result_t object_to_json_recursive_local(pool_t* pool, data_t** dst, const object_t* obj) {
+static result_t object_to_json_recursive_local(pool_t* pool, data_rope_t* dst, const object_t* obj) {
     if (!obj)
-        return data_append_str(pool, dst, "null");
+        return data_rope_append_str(pool, dst, "null");
     if (obj->data && !obj->child) {
         if (is_json_primitive_local(obj->data)) {
-            return data_append_data(pool, dst, obj->data);
+            return data_rope_append_data(pool, dst, obj->data);
         } else {
-            data_t* esc = NULL;
-            if (escape_json_data(pool, obj->data, &esc) != RESULT_OK)
-                RETURN_ERR("Failed to escape string for JSON output");
-            if (data_append_char(pool, dst, '"') != RESULT_OK)
-                RETURN_ERR("Failed to append to JSON output");
-            if (data_append_data(pool, dst, esc) != RESULT_OK)
+            if (data_rope_append_char(pool, dst, '"') != RESULT_OK)
                 RETURN_ERR("Failed to append to JSON output");
-            if (data_destroy(pool, esc) != RESULT_OK)
-                RETURN_ERR("Failed to free escaped buffer");
-            if (data_append_char(pool, dst, '"') != RESULT_OK)
+            if (data_rope_append_escape_json(pool, dst, obj->data) != RESULT_OK)
+                RETURN_ERR("Failed to escape string for JSON output");
+            if (data_rope_append_char(pool, dst, '"') != RESULT_OK)
                 RETURN_ERR("Failed to append to JSON output");
             return RESULT_OK;
         }
     }
     if (!obj->data && obj->child && obj->child->data && obj->child->child) {
-        if (data_append_char(pool, dst, '{') != RESULT_OK)
+        if (data_rope_append_char(pool, dst, '{') != RESULT_OK)
             RETURN_ERR("Failed to append '{' to JSON output");
         const object_t* ch = obj->child;
         int32_t first = 1;
         while (ch) {
             if (!first) {
-                if (data_append_char(pool, dst, ',') != RESULT_OK)
+                if (data_rope_append_char(pool, dst, ',') != RESULT_OK)
                     RETURN_ERR("Failed to append ',' to JSON output");
             }
             first = 0;
-            data_t* esc_key = NULL;
-            if (escape_json_data(pool, ch->data, &esc_key) != RESULT_OK)
-                RETURN_ERR("Failed to escape object key for JSON output");
-            if (data_append_char(pool, dst, '"') != RESULT_OK)
+            if (data_rope_append_char(pool, dst, '"') != RESULT_OK)
                 RETURN_ERR("Failed to append to JSON output");
-            if (data_append_data(pool, dst, esc_key) != RESULT_OK)
-                RETURN_ERR("Failed to append to JSON output");
-            if (data_destroy(pool, esc_key) != RESULT_OK)
-                RETURN_ERR("Failed to free escaped key buffer");
-            if (data_append_str(pool, dst, "\":") != RESULT_OK)
+            if (data_rope_append_escape_json(pool, dst, ch->data) != RESULT_OK)
+                RETURN_ERR("Failed to escape object key for JSON output");
+            if (data_rope_append_str(pool, dst, "\":") != RESULT_OK)
                 RETURN_ERR("Failed to append ':' to JSON output");
             if (object_to_json_recursive_local(pool, dst, ch->child) != RESULT_OK)
                 RETURN_ERR("Failed to serialize JSON value");
             ch = ch->next;
         }
-        if (data_append_char(pool, dst, '}') != RESULT_OK)
+        if (data_rope_append_char(pool, dst, '}') != RESULT_OK)
             RETURN_ERR("Failed to append '}' to JSON output");
         return RESULT_OK;
     } else if (!obj->data && obj->child) {
-        if (data_append_char(pool, dst, '[') != RESULT_OK)
+        if (data_rope_append_char(pool, dst, '[') != RESULT_OK)
             RETURN_ERR("Failed to append '[' to JSON output");
         const object_t* ch = obj->child;
         int32_t first = 1;
         while (ch) {
             if (!first) {
-                if (data_append_char(pool, dst, ',') != RESULT_OK)
+                if (data_rope_append_char(pool, dst, ',') != RESULT_OK)
                     RETURN_ERR("Failed to append ',' to JSON output");
             }
             first = 0;
@@ -497,22 +396,174 @@ static result_t object_to_json_recursive_local(pool_t* pool, data_t** dst, const
                 RETURN_ERR("Failed to serialize JSON array element");
             ch = ch->next;
         }
-        if (data_append_char(pool, dst, ']') != RESULT_OK)
+        if (data_rope_append_char(pool, dst, ']') != RESULT_OK)
             RETURN_ERR("Failed to append ']' to JSON output");
         return RESULT_OK;
     }
-    return data_append_str(pool, dst, "null");
+    return data_rope_append_str(pool, dst, "null");
+}
+
+result_t object_torope_json(pool_t* pool, data_rope_t* dst, const object_t* src) {
+    if (object_to_json_recursive_local(pool, dst, src) != RESULT_OK)
+        RETURN_ERR("Failed to serialize JSON into rope");
+    return RESULT_OK;
 }
 
+// Serializes into a rope and flattens once, so the output is copied a
+// single time however large it grows.
 result_t object_todata_json(pool_t* pool, data_t** dst, const object_t* src) {
-    if (!*dst) {
-        if (data_create(pool, dst) != RESULT_OK)
-            RETURN_ERR("Failed to create destination data buffer");
-    } else {
-        if (data_clean(pool, dst) != RESULT_OK)
-            RETURN_ERR("Failed to clear destination data buffer");
+    data_rope_t rope;
+    data_rope_init(&rope);
+    result_t result = object_torope_json(pool, &rope, src);
+    if (result == RESULT_OK)
+        result = data_rope_flatten(pool, dst, &rope);
+    if (data_rope_destroy(pool, &rope) != RESULT_OK)
+        RETURN_ERR("Failed to free JSON output rope");
+    if (result != RESULT_OK)
+        RETURN_ERR("Failed to serialize JSON document");
+    return RESULT_OK;
+}
+
+// Interned keys carry their hash, so most non-matching siblings are
+// rejected without touching their bytes.
+static uint64_t object_key_equal_local(const data_t* key, const char* seg, size_t si, uint64_t seg_hash) {
+    if (key->hash != 0 && key->hash != seg_hash) {
+        return 0;
+    }
+    return key->size == si && memcmp(key->data, seg, si) == 0;
+}
+
+// Objects at least OBJECT_INDEX_MINCOUNT keys wide get an open-addressed table
+// of (hash, predecessor, pair) slots after a header of (predecessor, last
+// child, last child's key hash); a predecessor equal to the object itself
+// stands for its child field. Only object_set_data maintains the index, so
+// code that edits an indexed object's child/next links or key data by hand
+// must call object_index_invalidate on it afterwards. A stale index is never
+// consulted: lookups walk the children and object_set_data rebuilds it. As a
+// safety net, a hit whose predecessor no longer links to it, or a cached tail
+// that no longer ends the list, also marks the index stale. size counts the
+// pairs.
+static uint64_t object_index_slots_local(const data_t* index) {
+    return 1ULL << (63 - __builtin_clzll(index->capacity / 24 - 1));
+}
+
+static uint64_t object_index_hash_local(const object_t* pair) {
+    if (!pair || !pair->data || !pair->child) {
+        return 0;
+    }
+    data_view_t key = data_view_data(pair->data);
+    return pair->data->hash != 0 ? pair->data->hash : data_view_hash(&key);
+}
+
+static const object_t* object_index_next_local(const object_t* object, uint64_t pred) {
+    const object_t* node = (const object_t*)(uintptr_t)pred;
+    return node == object ? object->child : node->next;
+}
+
+// Returns 1 with the pair, 0 when the key is absent, or -1 when stale. Keys
+// sharing a hash are told apart by their bytes.
+static int32_t object_index_find_local(const object_t* object, const char* seg, size_t si, uint64_t seg_hash, const object_t** pair) {
+    const uint64_t* header = (const uint64_t*)object->index->data;
+    const uint64_t* table = header + 3;
+    uint64_t mask = object_index_slots_local(object->index) - 1;
+    if (!header[0]) {
+        return -1;
+    }
+    for (uint64_t i = seg_hash & mask;; i = (i + 1) & mask) {
+        const uint64_t* slot = table + i * 3;
+        if (!slot[2]) {
+            const object_t* last = (const object_t*)(uintptr_t)header[1];
+            if (object_index_next_local(object, header[0]) != last || (last && (last->next || object_index_hash_local(last) != header[2]))) {
+                return -1;
+            }
+            return 0;
+        }
+        if (slot[0] == seg_hash) {
+            const object_t* node = (const object_t*)(uintptr_t)slot[2];
+            if (object_index_next_local(object, slot[1]) != node || !node->data || !node->child) {
+                return -1;
+            }
+            if (node->data->size == si && memcmp(node->data->data, seg, si) == 0) {
+                *pair = node;
+                return 1;
+            }
+        }
     }
-    return object_to_json_recursive_local(pool, dst, src);
+}
+
+// Keeps the first pair of a duplicated key, as the linear scan would.
+static void object_index_insert_local(const object_t* object, const object_t* pred, const object_t* pair, uint64_t hash) {
+    uint64_t* table = (uint64_t*)object->index->data + 3;
+    uint64_t mask = object_index_slots_local(object->index) - 1;
+    for (uint64_t i = hash & mask;; i = (i + 1) & mask) {
+        uint64_t* slot = table + i * 3;
+        if (!slot[2]) {
+            slot[0] = hash;
+            slot[1] = (uint64_t)(uintptr_t)pred;
+            slot[2] = (uint64_t)(uintptr_t)pair;
+            object->index->size++;
+            return;
+        }
+        if (slot[0] == hash) {
+            const data_t* key = ((const object_t*)(uintptr_t)slot[2])->data;
+            if (key && key->size == pair->data->size && memcmp(key->data, pair->data->data, key->size) == 0) {
+                return;
+            }
+        }
+    }
+}
+
+static void object_index_append_local(object_t* object, object_t* last, const object_t* pair, uint64_t hash) {
+    const object_t* pred = last ? last : object;
+    uint64_t* header = (uint64_t*)object->index->data;
+    object_index_insert_local(object, pred, pair, hash);
+    header[0] = (uint64_t)(uintptr_t)pred;
+    header[1] = (uint64_t)(uintptr_t)pair;
+    header[2] = hash;
+}
+
+static result_t object_index_build_local(pool_t* pool, object_t* object) {
+    uint64_t count = 0;
+    for (const object_t* child = object->child; child; child = child->next) {
+        count++;
+    }
+    data_t* index = NULL;
+    if (pool_data_alloc(pool, &index, (count * 4 + 1) * 24) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate object key index");
+    }
+    memset(index->data, 0, (object_index_slots_local(index) + 1) * 24);
+    index->size = 0;
+    if (object->index && data_destroy(pool, object->index) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy old object key index");
+    }
+    object->index = index;
+    const object_t* pred = object;
+    const object_t* last = NULL;
+    for (const object_t* child = object->child; child; child = child->next) {
+        if (last) {
+            pred = last;
+        }
+        uint64_t hash = object_index_hash_local(child);
+        if (hash != 0) {
+            object_index_insert_local(object, pred, child, hash);
+        }
+        last = child;
+    }
+    uint64_t* header = (uint64_t*)index->data;
+    header[0] = (uint64_t)(uintptr_t)pred;
+    header[1] = (uint64_t)(uintptr_t)last;
+    header[2] = object_index_hash_local(last);
+    return RESULT_OK;
+}
+
+result_t object_index_invalidate(object_t* object) {
+    if (!object) {
+        RETURN_ERR("Invalid arguments: object is required");
+    }
+    if (object->index) {
+        ((uint64_t*)object->index->data)[0] = 0;
+    }
+    return RESULT_OK;
 }
 
 result_t object_provide_str(object_t** dst, const object_t* object, const char* path) {
@@ -551,11 +602,18 @@ result_t object_provide_str(object_t** dst, const object_t* object, const char*
             }
             cur = child;
         } else {
+            data_view_t seg_view = {seg, si};
+            uint64_t seg_hash = data_view_hash(&seg_view);
             const object_t* child = cur->child;
+            const object_t* hit = NULL;
+            int32_t indexed = cur->index ? object_index_find_local(cur, seg, si, seg_hash, &hit) : -1;
+            if (indexed >= 0) {
+                child = hit;
+            }
             int32_t found = 0;
             while (child) {
                 if (child->data && child->child) {
-                    if (child->data->size == si && memcmp(child->data->data, seg, si) == 0) {
+                    if (object_key_equal_local(child->data, seg, si, seg_hash)) {
                         cur = child->child;
                         found = 1;
                         break;
@@ -609,11 +667,18 @@ result_t object_provide_data(object_t** dst, const object_t* object, const data_
             }
             cur = child;
         } else {
+            data_view_t seg_view = {seg, si};
+            uint64_t seg_hash = data_view_hash(&seg_view);
             const object_t* child = cur->child;
+            const object_t* hit = NULL;
+            int32_t indexed = cur->index ? object_index_find_local(cur, seg, si, seg_hash, &hit) : -1;
+            if (indexed >= 0) {
+                child = hit;
+            }
             int32_t found = 0;
             while (child) {
                 if (child->data && child->child) {
-                    if (child->data->size == si && memcmp(child->data->data, seg, si) == 0) {
+                    if (object_key_equal_local(child->data, seg, si, seg_hash)) {
                         cur = child->child;
                         found = 1;
                         break;
@@ -631,12 +696,10 @@ result_t object_provide_data(object_t** dst, const object_t* object, const data_
 }
 
 static const char* skip_xml_ws_local(const char* p, const char* end) {
-    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
-        p++;
-    return p;
+    return data_skip_any(p, end, " \t\n\r");
 }
 
-static result_t parse_xml_tag_name_local(pool_t* pool, const char** xml, const char* end, data_t** name) {
+static result_t parse_xml_tag_name_local(const char** xml, const char* end, data_view_t* name) {
     const char* p = *xml;
     if (p >= end || (!isalpha((unsigned char)*p) && *p != '_')) {
         RETURN_ERR("Invalid XML tag start: expected letter or '_' ");
@@ -644,12 +707,8 @@ static result_t parse_xml_tag_name_local(pool_t* pool, const char** xml, const c
     const char* start = p;
     while (p < end && (isalnum((unsigned char)*p) || *p == '-' || *p == '_' || *p == '.' || *p == ':'))
         p++;
-    size_t len = (size_t)(p - start);
-    if (pool_data_alloc(pool, name, len) != RESULT_OK) {
-        RETURN_ERR("Failed to allocate buffer for XML tag name");
-    }
-    (*name)->size = len;
-    memcpy((*name)->data, start, len);
+    name->data = start;
+    name->size = (uint64_t)(p - start);
     *xml = p;
     return RESULT_OK;
 }
@@ -657,8 +716,7 @@ static result_t parse_xml_tag_name_local(pool_t* pool, const char** xml, const c
 static result_t parse_xml_text_local(pool_t* pool, const char** xml, const char* end, data_t** out) {
     const char* p = *xml;
     const char* start = p;
-    while (p < end && *p != '<')
-        p++;
+    p = data_scan_any(p, end, "<");
     size_t len = (size_t)(p - start);
     while (len > 0 && (*start == ' ' || *start == '\t' || *start == '\n' || *start == '\r')) {
         start++;
@@ -681,9 +739,9 @@ static result_t parse_xml_text_local(pool_t* pool, const char** xml, const char*
     return RESULT_OK;
 }
 
-static result_t parse_xml_element_local(pool_t* pool, const char** xml, const char* end, object_t** out);
+static result_t parse_xml_element_local(pool_t* pool, pool_object_slab_t* slab, const char** xml, const char* end, object_t** out);
 
-static result_t parse_xml_content_local(pool_t* pool, const char** xml, const char* end, const data_t* tag_name, object_t** content) {
+static result_t parse_xml_content_local(pool_t* pool, pool_object_slab_t* slab, const char** xml, const char* end, const data_t* tag_name, object_t** content) {
     const char* p = *xml;
     p = skip_xml_ws_local(p, end);
     if (p < end && *p == '/') {
@@ -712,19 +770,14 @@ static result_t parse_xml_content_local(pool_t* pool, const char** xml, const ch
             if (p < end && *p == '/') {
                 p++;
                 p = skip_xml_ws_local(p, end);
-                data_t* closing = NULL;
-                if (parse_xml_tag_name_local(pool, &p, end, &closing) != RESULT_OK) {
+                data_view_t closing;
+                if (parse_xml_tag_name_local(&p, end, &closing) != RESULT_OK) {
                     RETURN_ERR("Failed to parse closing tag name");
                 }
-                if (closing->size != tag_name->size || memcmp(closing->data, tag_name->data, tag_name->size) != 0) {
-                    if (pool_data_free(pool, closing) != RESULT_OK) {
-                        RETURN_ERR("Failed to free closing tag buffer");
-                    }
+                data_view_t opening = data_view_data(tag_name);
+                if (!data_view_equal_view(&closing, &opening)) {
                     RETURN_ERR("Mismatched closing tag");
                 }
-                if (pool_data_free(pool, closing) != RESULT_OK) {
-                    RETURN_ERR("Failed to free closing tag buffer");
-                }
                 p = skip_xml_ws_local(p, end);
                 if (p >= end || *p != '>') {
                     RETURN_ERR("Malformed closing tag: expected '>'");
@@ -734,7 +787,7 @@ static result_t parse_xml_content_local(pool_t* pool, const char** xml, const ch
             } else {
                 p--;
                 object_t* child;
-                if (parse_xml_element_local(pool, &p, end, &child) != RESULT_OK) {
+                if (parse_xml_element_local(pool, slab, &p, end, &child) != RESULT_OK) {
                     RETURN_ERR("Failed to parse child XML element");
                 }
                 if (!first) {
@@ -782,39 +835,35 @@ static result_t parse_xml_content_local(pool_t* pool, const char** xml, const ch
     return RESULT_OK;
 }
 
-static result_t parse_xml_element_local(pool_t* pool, const char** xml, const char* end, object_t** out) {
+static result_t parse_xml_element_local(pool_t* pool, pool_object_slab_t* slab, const char** xml, const char* end, object_t** out) {
     const char* p = *xml;
     p = skip_xml_ws_local(p, end);
     if (p >= end || *p != '<') {
         RETURN_ERR("Expected '<' at start of XML element");
     }
     p++;
-    data_t* tag = NULL;
-    if (parse_xml_tag_name_local(pool, &p, end, &tag) != RESULT_OK) {
+    data_view_t tag_view;
+    if (parse_xml_tag_name_local(&p, end, &tag_view) != RESULT_OK) {
         RETURN_ERR("Failed to parse XML tag name");
     }
-    object_t* content;
-    if (pool_object_alloc(pool, &content) != RESULT_OK) {
-        if (pool_data_free(pool, tag) != RESULT_OK)
-            RETURN_ERR("Failed to free tag name buffer after alloc failure");
-        RETURN_ERR("Failed to allocate object for XML element content");
-    }
-    content->data = NULL;
-    content->child = NULL;
-    content->next = NULL;
-    if (parse_xml_content_local(pool, &p, end, tag, &content) != RESULT_OK) {
-        if (pool_data_free(pool, tag) != RESULT_OK)
-            RETURN_ERR("Failed to free tag name buffer after content parse failure");
-        RETURN_ERR("Failed to parse XML element content");
+    data_t* tag = NULL;
+    if ((pool->intern ? pool_intern(pool, &tag, &tag_view) : data_create_view(pool, &tag, &tag_view)) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate buffer for XML tag name");
     }
-    if (pool_object_alloc(pool, out) != RESULT_OK) {
+    if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
         if (pool_data_free(pool, tag) != RESULT_OK)
             RETURN_ERR("Failed to free tag name buffer after pair alloc failure");
         RETURN_ERR("Failed to allocate object for XML key/value pair");
     }
+    object_t* content;
+    if (pool_object_slab_alloc(pool, slab, &content) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate object for XML element content");
+    }
     (*out)->data = tag;
     (*out)->child = content;
-    (*out)->next = NULL;
+    if (parse_xml_content_local(pool, slab, &p, end, tag, &content) != RESULT_OK) {
+        RETURN_ERR("Failed to parse XML element content");
+    }
     *xml = p;
     return RESULT_OK;
 }
@@ -836,7 +885,8 @@ result_t object_parse_xml(pool_t* pool, object_t** dst, const data_t* src) {
             p += 2;
         p = skip_xml_ws_local(p, end);
     }
-    if (pool_object_alloc(pool, dst) != RESULT_OK) {
+    pool_object_slab_t slab = {NULL, NULL};
+    if (pool_object_slab_alloc(pool, &slab, dst) != RESULT_OK) {
         RETURN_ERR("Failed to allocate root XML object");
     }
     (*dst)->data = NULL;
@@ -844,6 +894,7 @@ result_t object_parse_xml(pool_t* pool, object_t** dst, const data_t* src) {
     (*dst)->next = NULL;
     object_t* first = NULL;
     object_t* last = NULL;
+    result_t result = RESULT_OK;
     while (p < end) {
         p = skip_xml_ws_local(p, end);
         if (p >= end)
@@ -865,8 +916,9 @@ result_t object_parse_xml(pool_t* pool, object_t** dst, const data_t* src) {
                 continue;
             }
             object_t* elem;
-            if (parse_xml_element_local(pool, &p, end, &elem) != RESULT_OK) {
-                RETURN_ERR("Failed to parse XML element");
+            result = parse_xml_element_local(pool, &slab, &p, end, &elem);
+            if (result != RESULT_OK) {
+                break;
             }
             if (!first) {
                 first = last = elem;
@@ -879,6 +931,12 @@ result_t object_parse_xml(pool_t* pool, object_t** dst, const data_t* src) {
                 p++;
         }
     }
+    if (pool_object_slab_close(pool, &slab) != RESULT_OK) {
+        RETURN_ERR("Failed to close object slab");
+    }
+    if (result != RESULT_OK) {
+        RETURN_ERR("Failed to parse XML element");
+    }
     (*dst)->child = first;
     return RESULT_OK;
 }
@@ -949,15 +1007,15 @@ static int32_t data_lexcmp_local(const data_t* a, const data_t* b) {
     return 0;
 }
 
-static result_t object_to_xml_recursive_local(pool_t* pool, data_t** dst, const object_t* src, const char* element_name) {
+static result_t object_to_xml_recursive_local(pool_t* pool, data_rope_t* dst, const object_t* src, const char* element_name) {
     if (!src) {
-        if (data_append_str(pool, dst, "<") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "<") != RESULT_OK) {
             RETURN_ERR("Failed to append '<' while serializing empty element");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing empty element");
         }
-        if (data_append_str(pool, dst, "/>") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "/>") != RESULT_OK) {
             RETURN_ERR("Failed to append '/>' while serializing empty element");
         }
         return RESULT_OK;
@@ -967,25 +1025,25 @@ static result_t object_to_xml_recursive_local(pool_t* pool, data_t** dst, const
         if (escape_xml_data(pool, src->data, &esc) != RESULT_OK) {
             RETURN_ERR("Failed to escape XML text content");
         }
-        if (data_append_str(pool, dst, "<") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "<") != RESULT_OK) {
             RETURN_ERR("Failed to append '<' while serializing element start");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing element start");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing element start");
         }
-        if (data_append_data(pool, dst, esc) != RESULT_OK) {
+        if (data_rope_append_data(pool, dst, esc) != RESULT_OK) {
             RETURN_ERR("Failed to append escaped text content to XML output");
         }
-        if (data_append_str(pool, dst, "</") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "</") != RESULT_OK) {
             RETURN_ERR("Failed to append '</' while serializing element end");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing element end");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing element end");
         }
         if (pool_data_free(pool, esc) != RESULT_OK) {
@@ -995,13 +1053,13 @@ static result_t object_to_xml_recursive_local(pool_t* pool, data_t** dst, const
     }
     object_t* first = src->child;
     if (first && first->data) {
-        if (data_append_str(pool, dst, "<") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "<") != RESULT_OK) {
             RETURN_ERR("Failed to append '<' while serializing object start");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing object start");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing object start");
         }
         const data_t* prev_key = NULL;
@@ -1062,24 +1120,24 @@ static result_t object_to_xml_recursive_local(pool_t* pool, data_t** dst, const
             prev_child = best;
             emitted++;
         }
-        if (data_append_str(pool, dst, "</") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "</") != RESULT_OK) {
             RETURN_ERR("Failed to append '</' while serializing object end");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing object end");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing object end");
         }
         return RESULT_OK;
     } else if (first) {
-        if (data_append_str(pool, dst, "<") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "<") != RESULT_OK) {
             RETURN_ERR("Failed to append '<' while serializing array start");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing array start");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing array start");
         }
         int32_t index = 0;
@@ -1089,38 +1147,31 @@ static result_t object_to_xml_recursive_local(pool_t* pool, data_t** dst, const
             if (object_to_xml_recursive_local(pool, dst, c, item_name) != RESULT_OK)
                 RETURN_ERR("Failed to serialize array item element");
         }
-        if (data_append_str(pool, dst, "</") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "</") != RESULT_OK) {
             RETURN_ERR("Failed to append '</' while serializing array end");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing array end");
         }
-        if (data_append_str(pool, dst, ">") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, ">") != RESULT_OK) {
             RETURN_ERR("Failed to append '>' while serializing array end");
         }
         return RESULT_OK;
     } else {
-        if (data_append_str(pool, dst, "<") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "<") != RESULT_OK) {
             RETURN_ERR("Failed to append '<' while serializing empty element");
         }
-        if (data_append_str(pool, dst, element_name) != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, element_name) != RESULT_OK) {
             RETURN_ERR("Failed to append element name while serializing empty element");
         }
-        if (data_append_str(pool, dst, "/>") != RESULT_OK) {
+        if (data_rope_append_str(pool, dst, "/>") != RESULT_OK) {
             RETURN_ERR("Failed to append '/>' while serializing empty element");
         }
         return RESULT_OK;
     }
 }
 
-result_t object_todata_xml(pool_t* pool, data_t** dst, const object_t* src) {
-    if (!*dst) {
-        if (data_create(pool, dst) != RESULT_OK)
-            RETURN_ERR("Failed to create destination buffer for XML output");
-    } else {
-        if (data_clean(pool, dst) != RESULT_OK)
-            RETURN_ERR("Failed to clear destination buffer for XML output");
-    }
+result_t object_torope_xml(pool_t* pool, data_rope_t* dst, const object_t* src) {
     if (src && src->child) {
         object_t* first = src->child;
         if (first && first->data) {
@@ -1198,6 +1249,19 @@ result_t object_todata_xml(pool_t* pool, data_t** dst, const object_t* src) {
     }
 }
 
+result_t object_todata_xml(pool_t* pool, data_t** dst, const object_t* src) {
+    data_rope_t rope;
+    data_rope_init(&rope);
+    result_t result = object_torope_xml(pool, &rope, src);
+    if (result == RESULT_OK)
+        result = data_rope_flatten(pool, dst, &rope);
+    if (data_rope_destroy(pool, &rope) != RESULT_OK)
+        RETURN_ERR("Failed to free XML output rope");
+    if (result != RESULT_OK)
+        RETURN_ERR("Failed to serialize XML document");
+    return RESULT_OK;
+}
+
 result_t object_set_data(pool_t* pool, object_t* object, const data_t* path, const data_t* data) {
     if (!object) {
         RETURN_ERR("Invalid argument: object is required");
@@ -1233,7 +1297,14 @@ result_t object_set_data(pool_t* pool, object_t* object, const data_t* path, con
         }
         
         if (is_index && si > 0) {
-            // Handle array index
+            // Handle array index. Positional writes can turn any child into a
+            // key, so an index on this object is dropped and rebuilt later.
+            if (target->index) {
+                if (data_destroy(pool, target->index) != RESULT_OK) {
+                    RETURN_ERR("Failed to destroy object key index");
+                }
+                target->index = NULL;
+            }
             size_t idx = (size_t)strtoull(seg, NULL, 10);
             object_t* child = target->child;
             size_t k = 0;
@@ -1247,19 +1318,34 @@ result_t object_set_data(pool_t* pool, object_t* object, const data_t* path, con
             target = child;
         } else {
             // Handle object key
-            object_t* child = target->child;
-            object_t* found = NULL;
+            data_view_t seg_view = {seg, si};
+            uint64_t seg_hash = data_view_hash(&seg_view);
+            const object_t* hit = NULL;
+            int32_t indexed = target->index ? object_index_find_local(target, seg, si, seg_hash, &hit) : -1;
+            object_t* found = indexed > 0 ? hit->child : NULL;
+            object_t* last = indexed == 0 ? (object_t*)(uintptr_t)((uint64_t*)target->index->data)[1] : NULL;
+            uint64_t count = 0;
             
-            while (child) {
-                if (child->data && child->child) {
-                    if (child->data->size == si && memcmp(child->data->data, seg, si) == 0) {
-                        found = child->child;
-                        break;
+            // Without a usable index, walk the children
+            if (indexed < 0) {
+                object_t* child = target->child;
+                while (child) {
+                    if (child->data && child->child) {
+                        if (object_key_equal_local(child->data, seg, si, seg_hash)) {
+                            found = child->child;
+                            break;
+                        }
                     }
+                    last = child;
+                    count++;
+                    child = child->next;
                 }
-                child = child->next;
             }
             
+            // Index wide objects once a lookup has had to walk them, and
+            // rebuild a stale or full index
+            uint64_t rebuild = indexed < 0 ? target->index != NULL || count >= OBJECT_INDEX_MINCOUNT : 0;
+            
             if (!found) {
                 // Create new key-value pair if not found
                 object_t* key_obj = NULL;
@@ -1273,24 +1359,30 @@ result_t object_set_data(pool_t* pool, object_t* object, const data_t* path, con
                 }
                 
                 // Set the key
-                if (data_create_str(pool, &key_obj->data, seg) != RESULT_OK) {
+                if ((pool->intern ? data_intern_view(pool, &key_obj->data, &seg_view) : data_create_str(pool, &key_obj->data, seg)) != RESULT_OK) {
                     RETURN_ERR("Failed to create key data for new path segment");
                 }
                 key_obj->child = value_obj;
                 
-                // Add to parent's children
-                if (!target->child) {
+                // Add to parent's children, appending at the indexed tail
+                if (!last) {
                     target->child = key_obj;
                 } else {
-                    object_t* last_child = target->child;
-                    while (last_child->next) {
-                        last_child = last_child->next;
-                    }
-                    last_child->next = key_obj;
+                    last->next = key_obj;
+                }
+                
+                if (indexed == 0 && (target->index->size + 1) * 4 <= object_index_slots_local(target->index) * 3) {
+                    object_index_append_local(target, last, key_obj, seg_hash);
+                } else if (indexed == 0 || count + 1 >= OBJECT_INDEX_MINCOUNT) {
+                    rebuild = 1;
                 }
                 
                 found = value_obj;
             }
+            
+            if (rebuild && object_index_build_local(pool, target) != RESULT_OK) {
+                RETURN_ERR("Failed to build object key index");
+            }
             target = found;
         }
     }
@@ -1347,3 +1439,1071 @@ result_t object_set_str(pool_t* pool, object_t* object, const char* path, const
     
     return result;
 }
+
+// Object JSON tape
+// Stage one classifies 64-byte blocks into bitmasks and records the offset of
+// every structural character, opening quote and scalar start. Stage two walks
+// those offsets and writes one 64-bit entry per value: the type character in
+// the top byte and a payload below it. Containers point at their partner
+// entry so subtrees can be skipped, strings and primitives point at a
+// length-prefixed copy in the strings buffer.
+#define OBJECT_TAPE_ENTRY(type, payload) (((uint64_t)(unsigned char)(type) << 56) | (payload))
+
+#if !defined(__x86_64__)
+static void object_tape_classify_scalar(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* op, uint64_t* space) {
+    uint64_t q = 0, b = 0, o = 0, s = 0;
+    for (uint64_t i = 0; i < 64; i++) {
+        uint64_t bit = 1ULL << i;
+        switch (p[i]) {
+        case '"':
+            q |= bit;
+            break;
+        case '\\':
+            b |= bit;
+            break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+            o |= bit;
+            break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            s |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+    *quote = q;
+    *backslash = b;
+    *op = o;
+    *space = s;
+}
+#endif
+
+#if defined(__x86_64__)
+static void object_tape_classify_sse2(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* op, uint64_t* space) {
+    uint64_t q = 0, b = 0, o = 0, s = 0;
+    for (uint64_t i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i * 16));
+        // '[' and ']' differ from '{' and '}' only in bit 0x20
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i ops = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        __m128i spaces = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        q |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << (i * 16);
+        b |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << (i * 16);
+        o |= (uint64_t)(uint16_t)_mm_movemask_epi8(ops) << (i * 16);
+        s |= (uint64_t)(uint16_t)_mm_movemask_epi8(spaces) << (i * 16);
+    }
+    *quote = q;
+    *backslash = b;
+    *op = o;
+    *space = s;
+}
+
+// Whitespace and operators are looked up by low nibble; bytes with the high
+// bit set shuffle to zero and never compare equal. Control bytes 0x0C and
+// 0x1A would alias ',' and ':' once 0x20 is set, so they are masked out.
+__attribute__((target("avx2"))) static void object_tape_classify_avx2(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* op, uint64_t* space) {
+    const __m256i space_table = _mm256_setr_epi8(' ', 100, 100, 100, 17, 100, 113, 2, 100, '\t', '\n', 112, 100, '\r', 100, 100,
+                                                 ' ', 100, 100, 100, 17, 100, 113, 2, 100, '\t', '\n', 112, 100, '\r', 100, 100);
+    const __m256i op_table = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0,
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0);
+    uint64_t q = 0, b = 0, o = 0, s = 0;
+    for (uint64_t i = 0; i < 2; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i * 32));
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        q |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << (i * 32);
+        b |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << (i * 32);
+        __m256i ops = _mm256_and_si256(_mm256_cmpeq_epi8(lower, _mm256_shuffle_epi8(op_table, v)), _mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x1F)));
+        o |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ops) << (i * 32);
+        s |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_shuffle_epi8(space_table, v))) << (i * 32);
+    }
+    *quote = q;
+    *backslash = b;
+    *op = o;
+    *space = s;
+}
+#endif
+
+// Drops escaped quotes from quote and returns the bytes inside strings,
+// counting each opening quote but not the closing one. carry[0] holds a
+// pending escape and carry[1] the string state between blocks.
+static uint64_t object_json_string_mask_local(uint64_t* quote, uint64_t backslash, uint64_t* carry) {
+    // A backslash escapes the byte after it unless it is escaped itself
+    uint64_t escaped = carry[0];
+    uint64_t pending = backslash & ~escaped;
+    carry[0] = 0;
+    while (pending != 0) {
+        uint64_t bit = pending & (0 - pending);
+        if (bit >> 63) {
+            carry[0] = 1;
+            break;
+        }
+        escaped |= bit << 1;
+        pending &= ~(bit | (bit << 1));
+    }
+    *quote &= ~escaped;
+    uint64_t in_string = *quote;
+    in_string ^= in_string << 1;
+    in_string ^= in_string << 2;
+    in_string ^= in_string << 4;
+    in_string ^= in_string << 8;
+    in_string ^= in_string << 16;
+    in_string ^= in_string << 32;
+    in_string ^= carry[1];
+    carry[1] = (uint64_t)((int64_t)in_string >> 63);
+    return in_string;
+}
+
+// Returns the closing quote of the string whose contents start at p. A quote
+// closes the string unless an odd run of backslashes precedes it.
+static const char* object_json_string_end_local(const char* p, const char* end) {
+    const char* start = p;
+    while (1) {
+        p = memchr(p, '"', (size_t)(end - p));
+        if (p == NULL) {
+            return NULL;
+        }
+        const char* q = p;
+        while (q > start && q[-1] == '\\')
+            q--;
+        if (((p - q) & 1) == 0) {
+            return p;
+        }
+        p++;
+    }
+}
+
+// Indexes [base, end) of src, which must start on a 64-byte boundary. The
+// escape, string and scalar state carries over between calls.
+static void object_tape_index_local(const char* src, uint64_t size, uint64_t base, uint64_t end, uint64_t* carry, uint32_t* index, uint64_t* count) {
+#if defined(__x86_64__)
+    uint64_t avx2 = (uint64_t)__builtin_cpu_supports("avx2");
+#endif
+    uint64_t n = 0;
+    char tail[64];
+    for (; base < end; base += 64) {
+        const char* block = src + base;
+        if (size - base < 64) {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, size - base);
+            block = tail;
+        }
+        uint64_t quote, backslash, op, space;
+#if defined(__x86_64__)
+        if (avx2) {
+            object_tape_classify_avx2(block, &quote, &backslash, &op, &space);
+        } else {
+            object_tape_classify_sse2(block, &quote, &backslash, &op, &space);
+        }
+#else
+        object_tape_classify_scalar(block, &quote, &backslash, &op, &space);
+#endif
+        uint64_t in_string = object_json_string_mask_local(&quote, backslash, carry);
+        uint64_t scalar = ~(op | space | quote | in_string);
+        uint64_t structural = (op & ~in_string) | (quote & in_string) | (scalar & ~((scalar << 1) | carry[2]));
+        carry[2] = scalar >> 63;
+        while (structural != 0) {
+            index[n++] = (uint32_t)(base + (uint64_t)__builtin_ctzll(structural));
+            structural &= structural - 1;
+        }
+    }
+    *count = n;
+}
+
+// Grows geometrically, since the tape buffers are filled one value at a time.
+static result_t object_tape_reserve_local(pool_t* pool, data_t** data, uint64_t capacity) {
+    if (capacity <= (*data)->capacity) {
+        return RESULT_OK;
+    }
+    if (capacity < (*data)->capacity * 2) {
+        capacity = (*data)->capacity * 2;
+    }
+    if (pool_data_realloc(pool, data, capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to grow tape buffer");
+    }
+    return RESULT_OK;
+}
+
+static result_t object_tape_string_local(pool_t* pool, object_tape_t* tape, const char* p, const char* end, uint64_t* offset) {
+    const char* start = p;
+    p = object_json_string_end_local(p, end);
+    if (p == NULL) {
+        RETURN_ERR("Unterminated JSON string literal");
+    }
+    uint64_t raw_len = (uint64_t)(p - start);
+    if (object_tape_reserve_local(pool, &tape->strings, tape->strings->size + sizeof(uint32_t) + raw_len) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve tape string");
+    }
+    *offset = tape->strings->size;
+    tape->strings->size += sizeof(uint32_t);
+    if (data_append_unescape_json(pool, &tape->strings, start, raw_len) != RESULT_OK) {
+        RETURN_ERR("Failed to decode JSON string");
+    }
+    uint32_t len = (uint32_t)(tape->strings->size - *offset - sizeof(uint32_t));
+    memcpy(tape->strings->data + *offset, &len, sizeof(len));
+    return RESULT_OK;
+}
+
+// Stage two pulls one window of the index at a time, so the index buffer
+// stays small however large the document is.
+static result_t object_tape_build_local(pool_t* pool, object_tape_t* tape, const data_t* src, uint32_t* index) {
+    const char* json = src->data;
+    const char* end = src->data + src->size;
+    uint64_t* entries = (uint64_t*)tape->entries->data;
+    uint64_t stack[OBJECT_TAPE_DEPTH_MAXCOUNT];
+    uint64_t carry[3] = {0, 0, 0};
+    uint64_t base = 0;
+    uint64_t count = 0;
+    uint64_t depth = 0;
+    uint64_t t = 0;
+    uint64_t i = 0;
+    // 0: value, 1: key, 2: ',' or close, 3: ':', 4: key or '}', 5: value or ']'
+    uint64_t state = 0;
+    while (state != 2 || depth != 0) {
+        if (i == count) {
+            if (base >= src->size) {
+                RETURN_ERR("Unexpected end of JSON input");
+            }
+            uint64_t window = src->size - base < OBJECT_TAPE_WINDOW_SIZE ? src->size - base : OBJECT_TAPE_WINDOW_SIZE;
+            object_tape_index_local(json, src->size, base, base + window, carry, index, &count);
+            base += window;
+            i = 0;
+            tape->entries->size = t * sizeof(uint64_t);
+            if (object_tape_reserve_local(pool, &tape->entries, (t + count) * sizeof(uint64_t)) != RESULT_OK) {
+                RETURN_ERR("Failed to reserve tape entries");
+            }
+            entries = (uint64_t*)tape->entries->data;
+            continue;
+        }
+        const char* p = json + index[i++];
+        char c = *p;
+        if ((state == 4 && c == '}') || (state == 5 && c == ']')) {
+            state = 2;
+        } else if (state == 4) {
+            state = 1;
+        } else if (state == 5) {
+            state = 0;
+        }
+        if (state == 0) {
+            if (c == '{' || c == '[') {
+                if (depth == OBJECT_TAPE_DEPTH_MAXCOUNT) {
+                    RETURN_ERR("JSON nesting exceeds maximum depth");
+                }
+                stack[depth++] = t;
+                entries[t++] = OBJECT_TAPE_ENTRY(c, 0);
+                state = c == '{' ? 4 : 5;
+            } else if (c == '"') {
+                uint64_t offset;
+                if (object_tape_string_local(pool, tape, p + 1, end, &offset) != RESULT_OK) {
+                    RETURN_ERR("Failed to parse JSON string value");
+                }
+                entries[t++] = OBJECT_TAPE_ENTRY('"', offset);
+                state = 2;
+            } else if (c == '}' || c == ']' || c == ',' || c == ':') {
+                RETURN_ERR("Unexpected character while parsing JSON value");
+            } else {
+                // Scalars end at the first whitespace or structural byte
+                const char* q = p;
+                while (q < end && *q != ',' && *q != ':' && *q != '{' && *q != '}' && *q != '[' && *q != ']' && *q != '"' && *q != ' ' && *q != '\t' && *q != '\n' && *q != '\r')
+                    q++;
+                uint32_t len = (uint32_t)(q - p);
+                if (object_tape_reserve_local(pool, &tape->strings, tape->strings->size + sizeof(len) + len) != RESULT_OK) {
+                    RETURN_ERR("Failed to reserve tape primitive");
+                }
+                uint64_t offset = tape->strings->size;
+                memcpy(tape->strings->data + offset, &len, sizeof(len));
+                memcpy(tape->strings->data + offset + sizeof(len), p, len);
+                tape->strings->size += sizeof(len) + len;
+                entries[t++] = OBJECT_TAPE_ENTRY('p', offset);
+                // An escaped quote outside a string is part of the scalar
+                if (q < end && *q == '"') {
+                    RETURN_ERR("Unexpected quote after JSON primitive");
+                }
+                state = 2;
+            }
+        } else if (state == 1) {
+            if (c != '"') {
+                RETURN_ERR("Expected string key in JSON object");
+            }
+            uint64_t offset;
+            if (object_tape_string_local(pool, tape, p + 1, end, &offset) != RESULT_OK) {
+                RETURN_ERR("Failed to parse JSON object key");
+            }
+            entries[t++] = OBJECT_TAPE_ENTRY('"', offset);
+            state = 3;
+        } else if (state == 3) {
+            if (c != ':') {
+                RETURN_ERR("Expected ':' after object key");
+            }
+            state = 0;
+        } else {
+            char open = (char)(entries[stack[depth - 1]] >> 56);
+            if (c == ',') {
+                state = open == '{' ? 1 : 0;
+            } else if ((c == '}' && open == '{') || (c == ']' && open == '[')) {
+                uint64_t start = stack[--depth];
+                entries[start] |= t;
+                entries[t++] = OBJECT_TAPE_ENTRY(c, start);
+            } else {
+                RETURN_ERR("Expected ',' or closing bracket in JSON container");
+            }
+        }
+    }
+    // Only whitespace may follow the root value
+    while (i == count && base < src->size) {
+        uint64_t window = src->size - base < OBJECT_TAPE_WINDOW_SIZE ? src->size - base : OBJECT_TAPE_WINDOW_SIZE;
+        object_tape_index_local(json, src->size, base, base + window, carry, index, &count);
+        base += window;
+        i = 0;
+    }
+    if (i != count) {
+        RETURN_ERR("Unexpected data after JSON value");
+    }
+    if (carry[1] != 0) {
+        RETURN_ERR("Unterminated JSON string literal");
+    }
+    tape->entries->size = t * sizeof(uint64_t);
+    return RESULT_OK;
+}
+
+// A tape initialized to {NULL, NULL} allocates its buffers on first use and
+// keeps them across parses, so reparsing into the same tape allocates nothing
+// once the buffers have grown to fit.
+result_t object_tape_parse_json(pool_t* pool, object_tape_t* tape, const data_t* src) {
+    if (!tape || !src || src->size == 0) {
+        RETURN_ERR("Empty JSON data");
+    }
+    if (src->size > UINT32_MAX) {
+        RETURN_ERR("JSON data too large for the structural index");
+    }
+    if (!data_utf8_valid(src)) {
+        RETURN_ERR("Invalid UTF-8 in JSON data");
+    }
+    if (!tape->entries && pool_data_alloc(pool, &tape->entries, 0) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate tape entries");
+    }
+    if (!tape->strings && pool_data_alloc(pool, &tape->strings, 0) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate tape strings");
+    }
+    tape->entries->size = 0;
+    tape->strings->size = 0;
+    // Typical JSON has a value every dozen bytes or more and strings that
+    // shrink when decoded, so these sizes rarely need to grow
+    if (object_tape_reserve_local(pool, &tape->entries, src->size / 2 + sizeof(uint64_t)) != RESULT_OK ||
+        object_tape_reserve_local(pool, &tape->strings, src->size + sizeof(uint32_t)) != RESULT_OK) {
+        RETURN_ERR("Failed to reserve tape buffers");
+    }
+    data_t* index = NULL;
+    if (pool_data_alloc(pool, &index, OBJECT_TAPE_WINDOW_SIZE * sizeof(uint32_t)) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate JSON structural index");
+    }
+    result_t result = object_tape_build_local(pool, tape, src, (uint32_t*)index->data);
+    if (data_destroy(pool, index) != RESULT_OK) {
+        RETURN_ERR("Failed to free JSON structural index");
+    }
+    if (result != RESULT_OK) {
+        tape->entries->size = 0;
+        RETURN_ERR("Failed to parse JSON document");
+    }
+    return RESULT_OK;
+}
+
+result_t object_tape_destroy(pool_t* pool, object_tape_t* tape) {
+    if (!tape) {
+        RETURN_ERR("Invalid tape");
+    }
+    if (tape->entries && data_destroy(pool, tape->entries) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy tape entries");
+    }
+    tape->entries = NULL;
+    if (tape->strings && data_destroy(pool, tape->strings) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy tape strings");
+    }
+    tape->strings = NULL;
+    return RESULT_OK;
+}
+
+char object_tape_type(const object_tape_t* tape, uint64_t index) {
+    return (char)(((const uint64_t*)tape->entries->data)[index] >> 56);
+}
+
+// Returns the entry following the value at index, skipping its subtree.
+uint64_t object_tape_next(const object_tape_t* tape, uint64_t index) {
+    uint64_t entry = ((const uint64_t*)tape->entries->data)[index];
+    char type = (char)(entry >> 56);
+    if (type == '{' || type == '[') {
+        return (entry & OBJECT_TAPE_PAYLOAD_MASK) + 1;
+    }
+    return index + 1;
+}
+
+data_view_t object_tape_view(const object_tape_t* tape, uint64_t index) {
+    data_view_t view = {NULL, 0};
+    uint64_t entry = ((const uint64_t*)tape->entries->data)[index];
+    char type = (char)(entry >> 56);
+    if (type != '"' && type != 'p') {
+        return view;
+    }
+    uint64_t offset = entry & OBJECT_TAPE_PAYLOAD_MASK;
+    uint32_t len;
+    memcpy(&len, tape->strings->data + offset, sizeof(len));
+    view.data = tape->strings->data + offset + sizeof(len);
+    view.size = len;
+    return view;
+}
+
+result_t object_tape_provide_str(uint64_t* dst, const object_tape_t* tape, const char* path) {
+    if (!dst || !tape || !tape->entries || tape->entries->size == 0 || !path) {
+        RETURN_ERR("Invalid arguments: tape and path are required");
+    }
+    uint64_t cur = 0;
+    const char* p = path;
+    while (*p) {
+        const char* seg = p;
+        while (*p && *p != '.')
+            p++;
+        data_view_t seg_view = {seg, (uint64_t)(p - seg)};
+        if (*p == '.')
+            p++;
+        char type = object_tape_type(tape, cur);
+        if (type == '[') {
+            int64_t idx = 0;
+            if (seg_view.size == 0 || data_view_toint(&seg_view, &idx) != RESULT_OK || idx < 0) {
+                RETURN_ERR("Invalid array index in path traversal");
+            }
+            uint64_t child = cur + 1;
+            while (idx > 0 && object_tape_type(tape, child) != ']') {
+                child = object_tape_next(tape, child);
+                idx--;
+            }
+            if (object_tape_type(tape, child) == ']') {
+                RETURN_ERR("Array index out of range in path traversal");
+            }
+            cur = child;
+        } else if (type == '{') {
+            uint64_t child = cur + 1;
+            while (object_tape_type(tape, child) != '}') {
+                data_view_t key = object_tape_view(tape, child);
+                if (data_view_equal_view(&key, &seg_view)) {
+                    break;
+                }
+                child = object_tape_next(tape, child + 1);
+            }
+            if (object_tape_type(tape, child) == '}') {
+                RETURN_ERR("Key not found in object during path traversal");
+            }
+            cur = child + 1;
+        } else {
+            RETURN_ERR("Path descends into a scalar JSON value");
+        }
+    }
+    *dst = cur;
+    return RESULT_OK;
+}
+
+static result_t object_tape_toobject_local(pool_t* pool, pool_object_slab_t* slab, const object_tape_t* tape, uint64_t* index, object_t** out) {
+    uint64_t i = *index;
+    char type = object_tape_type(tape, i);
+    if (pool_object_slab_alloc(pool, slab, out) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate object from pool");
+    }
+    (*out)->data = NULL;
+    (*out)->child = NULL;
+    (*out)->next = NULL;
+    if (type == '"' || type == 'p') {
+        data_view_t view = object_tape_view(tape, i);
+        if (data_create_view(pool, &(*out)->data, &view) != RESULT_OK) {
+            RETURN_ERR("Failed to create data for JSON value");
+        }
+        *index = i + 1;
+        return RESULT_OK;
+    }
+    char close = type == '{' ? '}' : ']';
+    object_t* last = NULL;
+    i++;
+    while (object_tape_type(tape, i) != close) {
+        object_t* node;
+        if (type == '{') {
+            if (pool_object_slab_alloc(pool, slab, &node) != RESULT_OK) {
+                RETURN_ERR("Failed to allocate key-value node from pool");
+            }
+            node->next = NULL;
+            node->child = NULL;
+            data_view_t key = object_tape_view(tape, i);
+            result_t result = pool->intern ? pool_intern(pool, &node->data, &key) : data_create_view(pool, &node->data, &key);
+            if (result != RESULT_OK) {
+                RETURN_ERR("Failed to create JSON object key");
+            }
+            i++;
+            if (object_tape_toobject_local(pool, slab, tape, &i, &node->child) != RESULT_OK) {
+                RETURN_ERR("Failed to materialize JSON object value");
+            }
+        } else if (object_tape_toobject_local(pool, slab, tape, &i, &node) != RESULT_OK) {
+            RETURN_ERR("Failed to materialize JSON array element");
+        }
+        if (last) {
+            last->next = node;
+        } else {
+            (*out)->child = node;
+        }
+        last = node;
+    }
+    *index = i + 1;
+    return RESULT_OK;
+}
+
+// Builds the same tree object_parse_json would for the value at index, so
+// callers can materialize only the subtrees they keep.
+result_t object_tape_toobject(pool_t* pool, object_t** dst, const object_tape_t* tape, uint64_t index) {
+    if (!dst || !tape || !tape->entries || index >= tape->entries->size / sizeof(uint64_t)) {
+        RETURN_ERR("Invalid arguments: tape and index are required");
+    }
+    pool_object_slab_t slab = {NULL, NULL};
+    result_t result = object_tape_toobject_local(pool, &slab, tape, &index, dst);
+    if (pool_object_slab_close(pool, &slab) != RESULT_OK) {
+        RETURN_ERR("Failed to close object slab");
+    }
+    if (result != RESULT_OK) {
+        RETURN_ERR("Failed to materialize JSON tape");
+    }
+    return RESULT_OK;
+}
+
+// Object JSON cursor
+// A cursor is a view of one raw JSON value. Navigation skips whatever is not
+// on the path without allocating or decoding it, and only the value at the
+// end of the path is materialized.
+#if !defined(__x86_64__)
+static void object_cursor_classify_scalar(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* open, uint64_t* close) {
+    uint64_t q = 0, b = 0, o = 0, c = 0;
+    for (uint64_t i = 0; i < 64; i++) {
+        uint64_t bit = 1ULL << i;
+        q |= p[i] == '"' ? bit : 0;
+        b |= p[i] == '\\' ? bit : 0;
+        o |= p[i] == '{' || p[i] == '[' ? bit : 0;
+        c |= p[i] == '}' || p[i] == ']' ? bit : 0;
+    }
+    *quote = q;
+    *backslash = b;
+    *open = o;
+    *close = c;
+}
+#endif
+
+#if defined(__x86_64__)
+static void object_cursor_classify_sse2(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* open, uint64_t* close) {
+    uint64_t q = 0, b = 0, o = 0, c = 0;
+    for (uint64_t i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i * 16));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        q |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << (i * 16);
+        b |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << (i * 16);
+        o |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{'))) << (i * 16);
+        c |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))) << (i * 16);
+    }
+    *quote = q;
+    *backslash = b;
+    *open = o;
+    *close = c;
+}
+
+__attribute__((target("avx2"))) static void object_cursor_classify_avx2(const char* p, uint64_t* quote, uint64_t* backslash, uint64_t* open, uint64_t* close) {
+    uint64_t q = 0, b = 0, o = 0, c = 0;
+    for (uint64_t i = 0; i < 2; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i * 32));
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        q |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << (i * 32);
+        b |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << (i * 32);
+        o |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{'))) << (i * 32);
+        c |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))) << (i * 32);
+    }
+    *quote = q;
+    *backslash = b;
+    *open = o;
+    *close = c;
+}
+#endif
+
+// Returns the byte after the bracket closing the container at p. Blocks with
+// fewer closing brackets than the current depth cannot end the container, so
+// only their counts are taken.
+static const char* object_cursor_skip_container_local(const char* p, const char* end) {
+#if defined(__x86_64__)
+    uint64_t avx2 = (uint64_t)__builtin_cpu_supports("avx2");
+#endif
+    uint64_t carry[2] = {0, 0};
+    uint64_t depth = 0;
+    char tail[64];
+    for (const char* base = p; base < end; base += 64) {
+        const char* block = base;
+        if (end - base < 64) {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, base, (size_t)(end - base));
+            block = tail;
+        }
+        uint64_t quote, backslash, open, close;
+#if defined(__x86_64__)
+        if (avx2) {
+            object_cursor_classify_avx2(block, &quote, &backslash, &open, &close);
+        } else {
+            object_cursor_classify_sse2(block, &quote, &backslash, &open, &close);
+        }
+#else
+        object_cursor_classify_scalar(block, &quote, &backslash, &open, &close);
+#endif
+        uint64_t in_string = object_json_string_mask_local(&quote, backslash, carry);
+        open &= ~in_string;
+        close &= ~in_string;
+        uint64_t closes = (uint64_t)__builtin_popcountll(close);
+        if (closes < depth) {
+            depth = depth + (uint64_t)__builtin_popcountll(open) - closes;
+            continue;
+        }
+        uint64_t brackets = open | close;
+        while (brackets != 0) {
+            uint64_t bit = brackets & (0 - brackets);
+            if (open & bit) {
+                depth++;
+            } else if (--depth == 0) {
+                return base + __builtin_ctzll(bit) + 1;
+            }
+            brackets &= brackets - 1;
+        }
+    }
+    return NULL;
+}
+
+static const char* object_cursor_skip_value_local(const char* p, const char* end) {
+    if (p >= end) {
+        return NULL;
+    }
+    if (*p == '"') {
+        p = object_json_string_end_local(p + 1, end);
+        return p ? p + 1 : NULL;
+    }
+    if (*p == '{' || *p == '[') {
+        return object_cursor_skip_container_local(p, end);
+    }
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+        p++;
+    return p == start ? NULL : p;
+}
+
+// Keys without escapes are compared in place. Escaped keys are decoded into
+// a stack buffer; any key longer than it decodes to more than 256 bytes.
+static uint64_t object_cursor_key_equal_local(const char* key, const char* key_end, const data_view_t* seg) {
+    uint64_t size = (uint64_t)(key_end - key);
+    if (memchr(key, '\\', size) == NULL) {
+        return size == seg->size && memcmp(key, seg->data, size) == 0;
+    }
+    char buf[256 * 6];
+    if (size > sizeof(buf) || seg->size > 256) {
+        return 0;
+    }
+    data_t decoded = {buf, sizeof(buf), 0, 0};
+    data_t* decoded_ptr = &decoded;
+    if (data_append_unescape_json(NULL, &decoded_ptr, key, size) != RESULT_OK) {
+        return 0;
+    }
+    return decoded.size == seg->size && memcmp(buf, seg->data, seg->size) == 0;
+}
+
+static result_t object_cursor_member_local(const char** json, const char* end, const data_view_t* seg) {
+    const char* p = skip_ws(*json + 1, end);
+    if (p < end && *p == '}') {
+        RETURN_ERR("Key not found in object during path traversal");
+    }
+    while (p < end) {
+        if (*p != '"') {
+            RETURN_ERR("Expected string key in JSON object");
+        }
+        const char* key_end = object_json_string_end_local(p + 1, end);
+        if (key_end == NULL) {
+            RETURN_ERR("Unterminated JSON string literal");
+        }
+        uint64_t found = object_cursor_key_equal_local(p + 1, key_end, seg);
+        p = skip_ws(key_end + 1, end);
+        if (p >= end || *p != ':') {
+            RETURN_ERR("Expected ':' after object key");
+        }
+        p = skip_ws(p + 1, end);
+        if (found) {
+            *json = p;
+            return RESULT_OK;
+        }
+        p = object_cursor_skip_value_local(p, end);
+        if (p == NULL) {
+            RETURN_ERR("Failed to skip JSON object value");
+        }
+        p = skip_ws(p, end);
+        if (p < end && *p == ',') {
+            p = skip_ws(p + 1, end);
+            continue;
+        }
+        if (p < end && *p == '}') {
+            RETURN_ERR("Key not found in object during path traversal");
+        }
+        RETURN_ERR("Expected ',' or '}' while parsing JSON object");
+    }
+    RETURN_ERR("Unterminated JSON object");
+}
+
+static result_t object_cursor_element_local(const char** json, const char* end, uint64_t index) {
+    const char* p = skip_ws(*json + 1, end);
+    if (p < end && *p == ']') {
+        RETURN_ERR("Array index out of range in path traversal");
+    }
+    for (; index > 0; index--) {
+        p = object_cursor_skip_value_local(p, end);
+        if (p == NULL) {
+            RETURN_ERR("Failed to skip JSON array element");
+        }
+        p = skip_ws(p, end);
+        if (p < end && *p == ']') {
+            RETURN_ERR("Array index out of range in path traversal");
+        }
+        if (p >= end || *p != ',') {
+            RETURN_ERR("Expected ',' or ']' while parsing JSON array");
+        }
+        p = skip_ws(p + 1, end);
+    }
+    *json = p;
+    return RESULT_OK;
+}
+
+// Resolves path like object_provide_str, returning the raw text of the value
+// found. Everything skipped on the way is checked only for bracket balance.
+result_t object_cursor_provide_str(data_view_t* dst, const data_view_t* src, const char* path) {
+    if (!dst || !src || !src->data || !path) {
+        RETURN_ERR("Invalid arguments: cursor and path are required");
+    }
+    const char* end = src->data + src->size;
+    const char* p = skip_ws(src->data, end);
+    while (*path) {
+        const char* seg = path;
+        while (*path && *path != '.')
+            path++;
+        data_view_t seg_view = {seg, (uint64_t)(path - seg)};
+        if (*path == '.')
+            path++;
+        if (p < end && *p == '{') {
+            if (object_cursor_member_local(&p, end, &seg_view) != RESULT_OK) {
+                RETURN_ERR("Failed to find JSON object member");
+            }
+        } else if (p < end && *p == '[') {
+            int64_t idx = 0;
+            if (seg_view.size == 0 || data_view_toint(&seg_view, &idx) != RESULT_OK || idx < 0) {
+                RETURN_ERR("Invalid array index in path traversal");
+            }
+            if (object_cursor_element_local(&p, end, (uint64_t)idx) != RESULT_OK) {
+                RETURN_ERR("Failed to find JSON array element");
+            }
+        } else {
+            RETURN_ERR("Path descends into a scalar JSON value");
+        }
+    }
+    const char* value_end = object_cursor_skip_value_local(p, end);
+    if (value_end == NULL) {
+        RETURN_ERR("Failed to find end of JSON value");
+    }
+    dst->data = p;
+    dst->size = (uint64_t)(value_end - p);
+    return RESULT_OK;
+}
+
+// Strings are decoded, primitives and containers are copied as raw text.
+result_t object_cursor_todata(pool_t* pool, data_t** dst, const data_view_t* src) {
+    if (!dst || !src || !src->data || src->size == 0) {
+        RETURN_ERR("Invalid arguments: cursor is required");
+    }
+    if (!data_view_utf8_valid(src)) {
+        RETURN_ERR("Invalid UTF-8 in JSON data");
+    }
+    if (src->data[0] != '"') {
+        if (data_create_view(pool, dst, src) != RESULT_OK) {
+            RETURN_ERR("Failed to copy JSON value");
+        }
+        return RESULT_OK;
+    }
+    // The cursor already ends at the closing quote, so decode without rescanning
+    if (src->size < 2 || src->data[src->size - 1] != '"') {
+        RETURN_ERR("Unterminated JSON string literal");
+    }
+    if (pool_data_alloc(pool, dst, src->size - 2) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate buffer for JSON string");
+    }
+    (*dst)->size = 0;
+    if (data_append_unescape_json(pool, dst, src->data + 1, src->size - 2) != RESULT_OK) {
+        RETURN_ERR("Failed to decode JSON string value");
+    }
+    return RESULT_OK;
+}
+
+result_t object_cursor_toobject(pool_t* pool, object_t** dst, const data_view_t* src) {
+    if (!dst || !src || !src->data || src->size == 0) {
+        RETURN_ERR("Invalid arguments: cursor is required");
+    }
+    if (!data_view_utf8_valid(src)) {
+        RETURN_ERR("Invalid UTF-8 in JSON data");
+    }
+    const char* p = src->data;
+    pool_object_slab_t slab = {NULL, NULL};
+    result_t result = parse_json_value_local(pool, &slab, &p, src->data + src->size, dst);
+    if (pool_object_slab_close(pool, &slab) != RESULT_OK) {
+        RETURN_ERR("Failed to close object slab");
+    }
+    if (result != RESULT_OK) {
+        RETURN_ERR("Failed to parse JSON value");
+    }
+    return RESULT_OK;
+}
+
+// Object JSON SAX
+// The push parser keeps its grammar state between chunks. A token cut by a
+// chunk boundary is carried in raw until it completes, and a backslash at
+// the end of a chunk is remembered so the escaped byte is skipped in the
+// next one. Tokens that fit in one chunk reach the handler straight from it.
+// Grammar states: 0 value, 1 key, 2 ',' or close, 3 ':', 4 key or '}',
+// 5 value or ']', 6 done, 7 failed. Tokens: 0 none, 1 key, 2 string,
+// 3 primitive.
+void object_sax_init(object_sax_t* sax, const object_sax_handler_t* handler, void* ctx) {
+    sax->handler = handler;
+    sax->ctx = ctx;
+    sax->raw = NULL;
+    sax->text = NULL;
+    object_sax_reset(sax);
+}
+
+// Keeps the buffers, so one parser can be reused across documents.
+void object_sax_reset(object_sax_t* sax) {
+    sax->state = 0;
+    sax->token = 0;
+    sax->escape = 0;
+    sax->depth = 0;
+    if (sax->raw) {
+        sax->raw->size = 0;
+    }
+}
+
+static result_t object_sax_spill_local(pool_t* pool, object_sax_t* sax, const char* p, const char* end) {
+    if (!sax->raw) {
+        if (pool_data_alloc(pool, &sax->raw, (uint64_t)(end - p)) != RESULT_OK) {
+            RETURN_ERR("Failed to allocate JSON token buffer");
+        }
+        sax->raw->size = 0;
+    }
+    data_view_t view = {p, (uint64_t)(end - p)};
+    if (data_append_view(pool, &sax->raw, &view) != RESULT_OK) {
+        RETURN_ERR("Failed to carry JSON token across chunks");
+    }
+    return RESULT_OK;
+}
+
+static result_t object_sax_emit_local(pool_t* pool, object_sax_t* sax, const char* p, const char* end) {
+    data_view_t view = {p, (uint64_t)(end - p)};
+    if (sax->raw && sax->raw->size > 0) {
+        if (data_append_view(pool, &sax->raw, &view) != RESULT_OK) {
+            RETURN_ERR("Failed to complete JSON token");
+        }
+        view = data_view_data(sax->raw);
+    }
+    // Validate the raw bytes, as escapes could otherwise pair up stray bytes
+    if (!data_view_utf8_valid(&view)) {
+        RETURN_ERR("Invalid UTF-8 in JSON data");
+    }
+    uint64_t token = sax->token;
+    if (token != 3 && memchr(view.data, '\\', view.size) != NULL) {
+        if (!sax->text) {
+            if (pool_data_alloc(pool, &sax->text, view.size) != RESULT_OK) {
+                RETURN_ERR("Failed to allocate JSON string buffer");
+            }
+        }
+        sax->text->size = 0;
+        if (data_append_unescape_json(pool, &sax->text, view.data, view.size) != RESULT_OK) {
+            RETURN_ERR("Failed to decode JSON string");
+        }
+        view = data_view_data(sax->text);
+    }
+    result_t (*callback)(void* ctx, const data_view_t* value) = token == 1 ? sax->handler->key : token == 2 ? sax->handler->string : sax->handler->primitive;
+    if (callback && callback(sax->ctx, &view) != RESULT_OK) {
+        RETURN_ERR("JSON handler rejected a value");
+    }
+    sax->token = 0;
+    if (sax->raw) {
+        sax->raw->size = 0;
+    }
+    sax->state = token == 1 ? 3 : sax->depth == 0 ? 6 : 2;
+    return RESULT_OK;
+}
+
+static result_t object_sax_feed_local(pool_t* pool, object_sax_t* sax, const char* p, const char* end) {
+    while (p < end) {
+        if (sax->token == 1 || sax->token == 2) {
+            const char* start = p;
+            if (sax->escape) {
+                sax->escape = 0;
+                p++;
+            }
+            while (p < end) {
+                p = data_scan_any(p, end, "\"\\");
+                if (p >= end || *p == '"')
+                    break;
+                if (p + 1 == end) {
+                    sax->escape = 1;
+                    p = end;
+                    break;
+                }
+                p += 2;
+            }
+            if (p >= end) {
+                return object_sax_spill_local(pool, sax, start, end);
+            }
+            if (object_sax_emit_local(pool, sax, start, p) != RESULT_OK) {
+                RETURN_ERR("Failed to emit JSON string");
+            }
+            p++;
+            continue;
+        }
+        if (sax->token == 3) {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != ':' && *p != '{' && *p != '}' && *p != '[' && *p != ']' && *p != '"' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+                p++;
+            if (p >= end) {
+                return object_sax_spill_local(pool, sax, start, end);
+            }
+            if (object_sax_emit_local(pool, sax, start, p) != RESULT_OK) {
+                RETURN_ERR("Failed to emit JSON primitive");
+            }
+            continue;
+        }
+        p = skip_ws(p, end);
+        if (p >= end) {
+            break;
+        }
+        char c = *p++;
+        if (sax->state == 6) {
+            RETURN_ERR("Unexpected data after JSON value");
+        }
+        if ((sax->state == 4 && c == '}') || (sax->state == 5 && c == ']')) {
+            sax->state = 2;
+        } else if (sax->state == 4) {
+            sax->state = 1;
+        } else if (sax->state == 5) {
+            sax->state = 0;
+        }
+        if (sax->state == 0) {
+            if (c == '{' || c == '[') {
+                if (sax->depth == OBJECT_SAX_DEPTH_MAXCOUNT) {
+                    RETURN_ERR("JSON nesting exceeds maximum depth");
+                }
+                uint64_t bit = 1ULL << (sax->depth % 64);
+                if (c == '{') {
+                    sax->stack[sax->depth / 64] |= bit;
+                } else {
+                    sax->stack[sax->depth / 64] &= ~bit;
+                }
+                sax->depth++;
+                result_t (*callback)(void* ctx) = c == '{' ? sax->handler->begin_object : sax->handler->begin_array;
+                if (callback && callback(sax->ctx) != RESULT_OK) {
+                    RETURN_ERR("JSON handler rejected a container");
+                }
+                sax->state = c == '{' ? 4 : 5;
+            } else if (c == '"') {
+                sax->token = 2;
+            } else if (c == '}' || c == ']' || c == ',' || c == ':') {
+                RETURN_ERR("Unexpected character while parsing JSON value");
+            } else {
+                sax->token = 3;
+                p--;
+            }
+        } else if (sax->state == 1) {
+            if (c != '"') {
+                RETURN_ERR("Expected string key in JSON object");
+            }
+            sax->token = 1;
+        } else if (sax->state == 3) {
+            if (c != ':') {
+                RETURN_ERR("Expected ':' after object key");
+            }
+            sax->state = 0;
+        } else {
+            uint64_t object = (sax->stack[(sax->depth - 1) / 64] >> ((sax->depth - 1) % 64)) & 1;
+            if (c == ',') {
+                sax->state = object ? 1 : 0;
+            } else if ((c == '}' && object) || (c == ']' && !object)) {
+                sax->depth--;
+                result_t (*callback)(void* ctx) = object ? sax->handler->end_object : sax->handler->end_array;
+                if (callback && callback(sax->ctx) != RESULT_OK) {
+                    RETURN_ERR("JSON handler rejected a container");
+                }
+                sax->state = sax->depth == 0 ? 6 : 2;
+            } else {
+                RETURN_ERR("Expected ',' or closing bracket in JSON container");
+            }
+        }
+    }
+    return RESULT_OK;
+}
+
+// A failed parser rejects further input until it is reset.
+result_t object_sax_feed(pool_t* pool, object_sax_t* sax, const data_view_t* chunk) {
+    if (!sax || !sax->handler || !chunk) {
+        RETURN_ERR("Invalid arguments: parser and chunk are required");
+    }
+    if (sax->state == 7) {
+        RETURN_ERR("JSON parser is in a failed state");
+    }
+    if (object_sax_feed_local(pool, sax, chunk->data, chunk->data + chunk->size) != RESULT_OK) {
+        sax->state = 7;
+        RETURN_ERR("Failed to parse JSON chunk");
+    }
+    return RESULT_OK;
+}
+
+// Ends the input. A primitive at the root has no delimiter after it, so it is
+// only emitted here.
+result_t object_sax_finish(pool_t* pool, object_sax_t* sax) {
+    if (!sax || !sax->handler) {
+        RETURN_ERR("Invalid arguments: parser is required");
+    }
+    if (sax->state == 7) {
+        RETURN_ERR("JSON parser is in a failed state");
+    }
+    if (sax->token == 3 && sax->depth == 0) {
+        const char* none = "";
+        if (object_sax_emit_local(pool, sax, none, none) != RESULT_OK) {
+            sax->state = 7;
+            RETURN_ERR("Failed to emit JSON primitive");
+        }
+    }
+    if (sax->state != 6 || sax->token != 0) {
+        sax->state = 7;
+        RETURN_ERR("Unexpected end of JSON input");
+    }
+    return RESULT_OK;
+}
+
+result_t object_sax_destroy(pool_t* pool, object_sax_t* sax) {
+    if (!sax) {
+        RETURN_ERR("Invalid parser");
+    }
+    if (sax->raw && data_destroy(pool, sax->raw) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy JSON token buffer");
+    }
+    sax->raw = NULL;
+    if (sax->text && data_destroy(pool, sax->text) != RESULT_OK) {
+        RETURN_ERR("Failed to destroy JSON string buffer");
+    }
+    sax->text = NULL;
+    return RESULT_OK;
+}
@@ -1,87 +1,1087 @@
 #include "lkjlib.h"
 
+#undef pool_data_alloc
+#undef pool_data_realloc
+#undef pool_object_alloc
+#undef pool_object_slab_alloc
+
 // Pool
-static void pool_data_init(char* data, data_t* datalist, data_t** freelist, uint64_t* freelist_count, uint64_t capacity, uint64_t count) {
+// The pool reserves address space for every size class up front and commits
+// it slab by slab as each class grows, so RSS tracks actual use.
+static uint64_t pool_align(uint64_t size, uint64_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+static result_t pool_commit(pool_t* pool, void* ptr, uint64_t size) {
+    uint64_t start = (uint64_t)ptr & ~(pool->page_size - 1);
+    uint64_t end = pool_align((uint64_t)ptr + size, pool->page_size);
+    if (mprotect((void*)start, end - start, PROT_READ | PROT_WRITE) != 0) {
+        RETURN_ERR("Failed to commit pool memory");
+    }
+    return RESULT_OK;
+}
+
+static void pool_lock(const pool_t* pool, pthread_mutex_t* lock) {
+    if (pool->concurrent) {
+        pthread_mutex_lock(lock);
+    }
+}
+
+static void pool_unlock(const pool_t* pool, pthread_mutex_t* lock) {
+    if (pool->concurrent) {
+        pthread_mutex_unlock(lock);
+    }
+}
+
+// Debug pools (built with POOL_DEBUG) follow every slot with a canary and
+// keep a record per slot of whether it is live and where it was allocated,
+// so overruns and double frees fail at free time and leaks are reported by
+// pool_destroy.
+static _Thread_local const char* pool_debug_file;
+static _Thread_local uint64_t pool_debug_line;
+
+void pool_debug_site(const char* file, uint64_t line) {
+    pool_debug_file = file;
+    pool_debug_line = line;
+}
+
+#ifdef POOL_DEBUG
+#define POOL_CANARY_BYTE 0xa5
+
+static const uint64_t pool_debug_size = sizeof(pool_debug_t);
+
+static void pool_canary_write(char* end) {
+    memset(end, POOL_CANARY_BYTE, POOL_CANARY_SIZE);
+}
+
+static result_t pool_canary_check(const char* end) {
+    for (uint64_t i = 0; i < POOL_CANARY_SIZE; i++) {
+        if ((unsigned char)end[i] != POOL_CANARY_BYTE) {
+            RETURN_ERR("Buffer overflow past data capacity");
+        }
+    }
+    return RESULT_OK;
+}
+
+static result_t pool_debug_take(pool_debug_t* debug, uint64_t maxcount, uint64_t index, char* end) {
+    if (index >= maxcount) {
+        RETURN_ERR("Allocated slot is outside of pool");
+    }
+    debug[index].file = pool_debug_file != NULL ? pool_debug_file : "unknown";
+    debug[index].line = pool_debug_line;
+    pool_debug_file = NULL;
+    pool_debug_line = 0;
+    __atomic_store_n(&debug[index].state, 1, __ATOMIC_RELAXED);
+    if (end != NULL) {
+        pool_canary_write(end);
+    }
+    return RESULT_OK;
+}
+
+static result_t pool_debug_give(pool_debug_t* debug, uint64_t maxcount, uint64_t index, const char* end) {
+    if (index >= maxcount) {
+        RETURN_ERR("Freed pointer does not belong to pool");
+    }
+    if (__atomic_exchange_n(&debug[index].state, 0, __ATOMIC_RELAXED) == 0) {
+        RETURN_ERR("Double free detected");
+    }
+    if (end != NULL && pool_canary_check(end) != RESULT_OK) {
+        RETURN_ERR("Canary was overwritten before free");
+    }
+    return RESULT_OK;
+}
+
+static void pool_debug_report_kind(const char* kind, const pool_debug_t* debug, uint64_t count, uint64_t capacity) {
+    char buf[512];
     for (uint64_t i = 0; i < count; i++) {
-        datalist[i].data = &data[i * capacity];
-        datalist[i].capacity = capacity;
-        freelist[i] = &datalist[i];
+        if (__atomic_load_n(&debug[i].state, __ATOMIC_RELAXED) == 0) {
+            continue;
+        }
+        int len = snprintf(buf, sizeof(buf), "{\"kind\": \"leak\", \"type\": \"%s\", \"file\": \"%s\", \"line\": %lu, \"capacity\": %lu}\n", kind, debug[i].file, debug[i].line, capacity);
+        if (len > 0) {
+            _Pragma("GCC diagnostic push");
+            _Pragma("GCC diagnostic ignored \"-Wunused-result\"");
+            write(STDERR_FILENO, buf, (uint64_t)len < sizeof(buf) ? (uint64_t)len : sizeof(buf) - 1);
+            _Pragma("GCC diagnostic pop");
+        }
     }
-    *freelist_count = count;
 }
 
-result_t pool_init(pool_t* pool) {
-    pool_data_init(pool->data16_data, pool->data16, pool->data16_freelist_data, &pool->data16_freelist_count, 16, POOL_data16_MAXCOUNT);
-    pool_data_init(pool->data256_data, pool->data256, pool->data256_freelist_data, &pool->data256_freelist_count, 256, POOL_data256_MAXCOUNT);
-    pool_data_init(pool->data4096_data, pool->data4096, pool->data4096_freelist_data, &pool->data4096_freelist_count, 4096, POOL_data4096_MAXCOUNT);
-    pool_data_init(pool->data65536_data, pool->data65536, pool->data65536_freelist_data, &pool->data65536_freelist_count, 65536, POOL_data65536_MAXCOUNT);
-    pool_data_init(pool->data1048576_data, pool->data1048576, pool->data1048576_freelist_data, &pool->data1048576_freelist_count, 1048576, POOL_data1048576_MAXCOUNT);
-    for (uint64_t i = 0; i < POOL_OBJECT_MAXCOUNT; i++) {
-        pool->object_freelist_data[i] = &pool->object_data[i];
-        pool->object_data[i].data = NULL;
-        pool->object_data[i].child = NULL;
-        pool->object_data[i].next = NULL;
+static void pool_debug_report(const pool_t* pool) {
+    for (uint64_t i = 0; i < pool->class_count; i++) {
+        pool_debug_report_kind("data", pool->classes[i].debug, pool->classes[i].count, pool->classes[i].capacity);
+    }
+    pool_debug_report_kind("object", pool->object_debug, pool->object_count, sizeof(object_t));
+    for (uint64_t i = 0; i < pool->huge_count; i++) {
+        if (pool->huge_data[i].data != NULL) {
+            pool_debug_report_kind("huge", &pool->huge_debug[i], 1, pool->huge_data[i].capacity);
+        }
     }
-    pool->object_freelist_count = POOL_OBJECT_MAXCOUNT;
+}
+#else
+static const uint64_t pool_debug_size = 0;
+
+static void pool_canary_write(char* end) {
+    (void)end;
+}
+
+static result_t pool_canary_check(const char* end) {
+    (void)end;
     return RESULT_OK;
 }
 
-result_t pool_object_alloc(pool_t* pool, object_t** obj) {
-    if (pool->object_freelist_count == 0) {
-        RETURN_ERR("No available object in pool");
+static result_t pool_debug_take(pool_debug_t* debug, uint64_t maxcount, uint64_t index, char* end) {
+    (void)debug;
+    (void)maxcount;
+    (void)index;
+    (void)end;
+    return RESULT_OK;
+}
+
+static result_t pool_debug_give(pool_debug_t* debug, uint64_t maxcount, uint64_t index, const char* end) {
+    (void)debug;
+    (void)maxcount;
+    (void)index;
+    (void)end;
+    return RESULT_OK;
+}
+
+static void pool_debug_report(const pool_t* pool) {
+    (void)pool;
+}
+#endif
+
+static result_t pool_class_grow(pool_t* pool, pool_class_t* cls) {
+    if (cls->count >= cls->maxcount) {
+        RETURN_ERR("Size class is exhausted");
+    }
+    uint64_t stride = cls->capacity + POOL_CANARY_SIZE;
+    uint64_t n = POOL_SLAB_SIZE / stride;
+    if (n == 0) {
+        n = 1;
+    }
+    if (n > cls->maxcount - cls->count) {
+        n = cls->maxcount - cls->count;
+    }
+    if (pool_commit(pool, &cls->slot_data[cls->count * stride], n * stride) != RESULT_OK ||
+        pool_commit(pool, &cls->data[cls->count], n * sizeof(data_t)) != RESULT_OK ||
+        pool_commit(pool, &cls->freelist_data[cls->count], n * sizeof(data_t*)) != RESULT_OK ||
+        (cls->debug != NULL && pool_commit(pool, &cls->debug[cls->count], n * sizeof(pool_debug_t)) != RESULT_OK)) {
+        RETURN_ERR("Failed to commit slab for size class");
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        data_t* slot = &cls->data[cls->count + n - 1 - i];
+        slot->data = &cls->slot_data[(cls->count + n - 1 - i) * stride];
+        slot->capacity = cls->capacity;
+        slot->size = 0;
+        slot->hash = 0;
+        cls->freelist_data[cls->freelist_count++] = slot;
+    }
+    cls->count += n;
+    return RESULT_OK;
+}
+
+// Counters are bumped atomically in concurrent pools, where allocations
+// served from thread magazines never take the class lock.
+static void pool_stats_alloc(const pool_t* pool, pool_stats_t* stats) {
+    if (pool->concurrent) {
+        __atomic_fetch_add(&stats->allocs, 1, __ATOMIC_RELAXED);
+        uint64_t used = __atomic_add_fetch(&stats->used, 1, __ATOMIC_RELAXED);
+        uint64_t high_water = __atomic_load_n(&stats->high_water, __ATOMIC_RELAXED);
+        while (used > high_water && !__atomic_compare_exchange_n(&stats->high_water, &high_water, used, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+    } else {
+        stats->allocs++;
+        if (++stats->used > stats->high_water) {
+            stats->high_water = stats->used;
+        }
+    }
+}
+
+static void pool_stats_free(const pool_t* pool, pool_stats_t* stats) {
+    if (pool->concurrent) {
+        __atomic_fetch_add(&stats->frees, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_sub(&stats->used, 1, __ATOMIC_RELAXED);
+    } else {
+        stats->frees++;
+        stats->used--;
+    }
+}
+
+static void pool_stats_fail(const pool_t* pool, pool_stats_t* stats) {
+    if (pool->concurrent) {
+        __atomic_fetch_add(&stats->failed, 1, __ATOMIC_RELAXED);
+    } else {
+        stats->failed++;
+    }
+}
+
+static void pool_stats_snapshot(const pool_stats_t* stats, pool_stats_t* dst) {
+    dst->allocs = __atomic_load_n(&stats->allocs, __ATOMIC_RELAXED);
+    dst->frees = __atomic_load_n(&stats->frees, __ATOMIC_RELAXED);
+    dst->used = __atomic_load_n(&stats->used, __ATOMIC_RELAXED);
+    dst->high_water = __atomic_load_n(&stats->high_water, __ATOMIC_RELAXED);
+    dst->failed = __atomic_load_n(&stats->failed, __ATOMIC_RELAXED);
+}
+
+static uint64_t pool_class_available(const pool_class_t* cls) {
+    return cls->freelist_count > 0 || cls->count < cls->maxcount;
+}
+
+static result_t pool_class_pop(pool_t* pool, pool_class_t* cls, data_t** data) {
+    if (cls->freelist_count == 0) {
+        if (pool_class_grow(pool, cls) != RESULT_OK) {
+            RETURN_ERR("Failed to grow size class");
+        }
+    }
+    *data = cls->freelist_data[--cls->freelist_count];
+    return RESULT_OK;
+}
+
+static result_t pool_class_push(pool_class_t* cls, data_t* data) {
+    if (cls->freelist_count >= cls->count) {
+        RETURN_ERR("Freelist overflow for data");
+    }
+    cls->freelist_data[cls->freelist_count++] = data;
+    return RESULT_OK;
+}
+
+// The object array is carved into chunks of POOL_OBJECT_CHUNK_SIZE nodes.
+// A chunk either feeds the single-object freelist for good, or backs
+// document slabs: parsers bump-allocate whole trees from it in parse order
+// and it returns to the chunk freelist once its live count drops to zero.
+#define POOL_OBJECT_CHUNK_SINGLE UINT64_MAX
+
+static result_t pool_object_chunk_take(pool_t* pool, uint64_t* chunk) {
+    if (pool->object_chunk_freelist_count > 0) {
+        *chunk = pool->object_chunk_freelist_data[--pool->object_chunk_freelist_count];
+        return RESULT_OK;
+    }
+    if (pool->object_count >= pool->object_maxcount) {
+        RETURN_ERR("Object pool is exhausted");
+    }
+    uint64_t n = POOL_OBJECT_CHUNK_SIZE;
+    if (pool_commit(pool, &pool->object_data[pool->object_count], n * sizeof(object_t)) != RESULT_OK ||
+        pool_commit(pool, &pool->object_freelist_data[pool->object_count], n * sizeof(object_t*)) != RESULT_OK ||
+        (pool->object_debug != NULL && pool_commit(pool, &pool->object_debug[pool->object_count], n * sizeof(pool_debug_t)) != RESULT_OK)) {
+        RETURN_ERR("Failed to commit chunk for objects");
+    }
+    *chunk = pool->object_count / POOL_OBJECT_CHUNK_SIZE;
+    pool->object_count += n;
+    return RESULT_OK;
+}
+
+static void pool_object_chunk_release(pool_t* pool, uint64_t chunk, uint64_t count) {
+    if (__atomic_sub_fetch(&pool->object_chunk_live[chunk], count, __ATOMIC_RELAXED) == 0) {
+        pool_lock(pool, &pool->object_lock);
+        pool->object_chunk_freelist_data[pool->object_chunk_freelist_count++] = chunk;
+        pool_unlock(pool, &pool->object_lock);
+    }
+}
+
+static result_t pool_object_grow(pool_t* pool) {
+    uint64_t chunk = 0;
+    if (pool_object_chunk_take(pool, &chunk) != RESULT_OK) {
+        RETURN_ERR("Failed to take chunk for single objects");
+    }
+    __atomic_store_n(&pool->object_chunk_live[chunk], POOL_OBJECT_CHUNK_SINGLE, __ATOMIC_RELAXED);
+    object_t* base = &pool->object_data[chunk * POOL_OBJECT_CHUNK_SIZE];
+    for (uint64_t i = 0; i < POOL_OBJECT_CHUNK_SIZE; i++) {
+        pool->object_freelist_data[pool->object_freelist_count++] = &base[POOL_OBJECT_CHUNK_SIZE - 1 - i];
+    }
+    return RESULT_OK;
+}
+
+// Continues the pool's leftover tail when one exists, so consecutive small
+// documents share a chunk instead of each pinning their own.
+static result_t pool_object_slab_refill(pool_t* pool, pool_object_slab_t* slab) {
+    if (pool->object_tail.next != pool->object_tail.end) {
+        *slab = pool->object_tail;
+        pool->object_tail.next = NULL;
+        pool->object_tail.end = NULL;
+        return RESULT_OK;
+    }
+    uint64_t chunk = 0;
+    if (pool_object_chunk_take(pool, &chunk) != RESULT_OK) {
+        RETURN_ERR("Failed to take chunk for object slab");
+    }
+    __atomic_store_n(&pool->object_chunk_live[chunk], POOL_OBJECT_CHUNK_SIZE, __ATOMIC_RELAXED);
+    slab->next = &pool->object_data[chunk * POOL_OBJECT_CHUNK_SIZE];
+    slab->end = slab->next + POOL_OBJECT_CHUNK_SIZE;
+    return RESULT_OK;
+}
+
+static result_t pool_object_pop(pool_t* pool, object_t** obj) {
+    if (pool->object_freelist_count == 0 && pool_object_grow(pool) != RESULT_OK) {
+        RETURN_ERR("Failed to grow object pool");
     }
     *obj = pool->object_freelist_data[--pool->object_freelist_count];
+    return RESULT_OK;
+}
+
+static result_t pool_object_push(pool_t* pool, object_t* obj) {
+    if (pool->object_freelist_count >= pool->object_count) {
+        RETURN_ERR("Freelist overflow for object");
+    }
+    pool->object_freelist_data[pool->object_freelist_count++] = obj;
+    return RESULT_OK;
+}
+
+// Concurrent pools put a per-thread magazine in front of every size class
+// and the object freelist. A thread claims a pool_cache_t slot on first use
+// and gives it back from the pool's key destructor when it exits. Magazines
+// refill from and spill into the shared depot half a magazine at a time
+// under the class lock, so blocks freed on a thread other than the
+// allocating one drift back to the depot lazily.
+static pool_cache_t pool_cache_none;
+
+static void pool_cache_release(void* value) {
+    pool_cache_t* cache = value;
+    if (cache == NULL || cache == &pool_cache_none) {
+        return;
+    }
+    pool_t* pool = cache->pool;
+    for (uint64_t i = 0; i < pool->class_count; i++) {
+        pthread_mutex_lock(&pool->classes[i].lock);
+        while (cache->data_count[i] > 0 && pool_class_push(&pool->classes[i], cache->data[i][cache->data_count[i] - 1]) == RESULT_OK) {
+            cache->data_count[i]--;
+        }
+        pthread_mutex_unlock(&pool->classes[i].lock);
+    }
+    pthread_mutex_lock(&pool->object_lock);
+    while (cache->object_count > 0 && pool_object_push(pool, cache->object[cache->object_count - 1]) == RESULT_OK) {
+        cache->object_count--;
+    }
+    pthread_mutex_unlock(&pool->object_lock);
+    pthread_mutex_lock(&pool->cache_lock);
+    cache->active = 0;
+    pthread_mutex_unlock(&pool->cache_lock);
+}
+
+static pool_cache_t* pool_cache_get(pool_t* pool) {
+    pool_cache_t* cache = pthread_getspecific(pool->cache_key);
+    if (cache != NULL) {
+        return cache == &pool_cache_none ? NULL : cache;
+    }
+    pthread_mutex_lock(&pool->cache_lock);
+    for (uint64_t i = 0; i < pool->cache_count && cache == NULL; i++) {
+        if (!pool->caches[i].active) {
+            cache = &pool->caches[i];
+        }
+    }
+    if (cache == NULL && pool->cache_count < POOL_CACHE_MAXCOUNT &&
+        pool_commit(pool, &pool->caches[pool->cache_count], sizeof(pool_cache_t)) == RESULT_OK) {
+        cache = &pool->caches[pool->cache_count++];
+    }
+    if (cache != NULL) {
+        cache->pool = pool;
+        cache->active = 1;
+    }
+    pthread_mutex_unlock(&pool->cache_lock);
+    pthread_setspecific(pool->cache_key, cache != NULL ? cache : &pool_cache_none);
+    return cache;
+}
+
+static result_t pool_class_alloc(pool_t* pool, pool_class_t* cls, data_t** data) {
+    pool_cache_t* cache = pool->concurrent ? pool_cache_get(pool) : NULL;
+    if (cache == NULL) {
+        pool_lock(pool, &cls->lock);
+        result_t result = pool_class_pop(pool, cls, data);
+        pool_unlock(pool, &cls->lock);
+        if (result != RESULT_OK) {
+            pool_stats_fail(pool, &cls->stats);
+            RETURN_ERR("Failed to take data from size class");
+        }
+        if (pool_debug_take(cls->debug, cls->maxcount, (uint64_t)(*data - cls->data), (*data)->data + cls->capacity) != RESULT_OK) {
+            RETURN_ERR("Failed to track data from size class");
+        }
+        pool_stats_alloc(pool, &cls->stats);
+        return RESULT_OK;
+    }
+    uint64_t index = (uint64_t)(cls - pool->classes);
+    if (cache->data_count[index] == 0) {
+        pthread_mutex_lock(&cls->lock);
+        while (cache->data_count[index] < POOL_CACHE_SIZE / 2 && pool_class_available(cls) &&
+               pool_class_pop(pool, cls, &cache->data[index][cache->data_count[index]]) == RESULT_OK) {
+            cache->data_count[index]++;
+        }
+        pthread_mutex_unlock(&cls->lock);
+        if (cache->data_count[index] == 0) {
+            pool_stats_fail(pool, &cls->stats);
+            RETURN_ERR("Failed to refill thread cache for size class");
+        }
+    }
+    *data = cache->data[index][--cache->data_count[index]];
+    if (pool_debug_take(cls->debug, cls->maxcount, (uint64_t)(*data - cls->data), (*data)->data + cls->capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to track data from thread cache");
+    }
+    pool_stats_alloc(pool, &cls->stats);
+    return RESULT_OK;
+}
+
+static result_t pool_class_free(pool_t* pool, pool_class_t* cls, data_t* data) {
+    if (pool_debug_give(cls->debug, cls->maxcount, (uint64_t)(data - cls->data), data->data + cls->capacity) != RESULT_OK) {
+        RETURN_ERR("Refusing to free corrupted data");
+    }
+    pool_cache_t* cache = pool->concurrent ? pool_cache_get(pool) : NULL;
+    if (cache == NULL) {
+        pool_lock(pool, &cls->lock);
+        result_t result = pool_class_push(cls, data);
+        pool_unlock(pool, &cls->lock);
+        if (result != RESULT_OK) {
+            RETURN_ERR("Failed to return data to size class");
+        }
+        pool_stats_free(pool, &cls->stats);
+        return RESULT_OK;
+    }
+    uint64_t index = (uint64_t)(cls - pool->classes);
+    if (cache->data_count[index] == POOL_CACHE_SIZE) {
+        result_t result = RESULT_OK;
+        pthread_mutex_lock(&cls->lock);
+        while (result == RESULT_OK && cache->data_count[index] > POOL_CACHE_SIZE / 2) {
+            result = pool_class_push(cls, cache->data[index][--cache->data_count[index]]);
+        }
+        pthread_mutex_unlock(&cls->lock);
+        if (result != RESULT_OK) {
+            RETURN_ERR("Failed to spill thread cache for size class");
+        }
+    }
+    cache->data[index][cache->data_count[index]++] = data;
+    pool_stats_free(pool, &cls->stats);
+    return RESULT_OK;
+}
+
+static result_t pool_huge_grow(pool_t* pool) {
+    if (pool->huge_count >= pool->huge_maxcount) {
+        RETURN_ERR("Huge descriptor pool is exhausted");
+    }
+    uint64_t n = POOL_SLAB_SIZE / sizeof(data_t);
+    if (n > pool->huge_maxcount - pool->huge_count) {
+        n = pool->huge_maxcount - pool->huge_count;
+    }
+    if (pool_commit(pool, &pool->huge_data[pool->huge_count], n * sizeof(data_t)) != RESULT_OK ||
+        pool_commit(pool, &pool->huge_freelist_data[pool->huge_count], n * sizeof(data_t*)) != RESULT_OK ||
+        (pool->huge_debug != NULL && pool_commit(pool, &pool->huge_debug[pool->huge_count], n * sizeof(pool_debug_t)) != RESULT_OK)) {
+        RETURN_ERR("Failed to commit slab for huge descriptors");
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        data_t* slot = &pool->huge_data[pool->huge_count + n - 1 - i];
+        slot->data = NULL;
+        slot->capacity = 0;
+        slot->size = 0;
+        slot->hash = 0;
+        pool->huge_freelist_data[pool->huge_freelist_count++] = slot;
+    }
+    pool->huge_count += n;
+    return RESULT_OK;
+}
+
+// Allocations above the largest class get their own mapping, so they can
+// grow with mremap instead of being copied between fixed slabs.
+static uint64_t pool_is_huge(const pool_t* pool, uint64_t capacity) {
+    return capacity > pool->classes[pool->class_count - 1].capacity;
+}
+
+static result_t pool_huge_alloc(pool_t* pool, data_t** data, uint64_t capacity) {
+    capacity = pool_align(capacity, pool->page_size);
+    void* mem = mmap(NULL, capacity + POOL_CANARY_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        pool_stats_fail(pool, &pool->huge_stats);
+        RETURN_ERR("Failed to map huge allocation");
+    }
+    pool_lock(pool, &pool->huge_lock);
+    if (pool->huge_freelist_count == 0 && pool_huge_grow(pool) != RESULT_OK) {
+        pool_unlock(pool, &pool->huge_lock);
+        munmap(mem, capacity + POOL_CANARY_SIZE);
+        pool_stats_fail(pool, &pool->huge_stats);
+        RETURN_ERR("No available huge descriptor in pool");
+    }
+    *data = pool->huge_freelist_data[--pool->huge_freelist_count];
+    pool_unlock(pool, &pool->huge_lock);
+    (*data)->data = mem;
+    (*data)->capacity = capacity;
+    (*data)->size = 0;
+    if (pool_debug_take(pool->huge_debug, pool->huge_maxcount, (uint64_t)(*data - pool->huge_data), (*data)->data + capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to track huge data");
+    }
+    pool_stats_alloc(pool, &pool->huge_stats);
+    return RESULT_OK;
+}
+
+static result_t pool_huge_free(pool_t* pool, data_t* data) {
+    if (data < pool->huge_data || data >= pool->huge_data + pool->huge_count || data->data == NULL) {
+        RETURN_ERR("Data is not a live huge allocation");
+    }
+    if (pool_debug_give(pool->huge_debug, pool->huge_maxcount, (uint64_t)(data - pool->huge_data), data->data + data->capacity) != RESULT_OK) {
+        RETURN_ERR("Refusing to free corrupted huge data");
+    }
+    if (munmap(data->data, data->capacity + POOL_CANARY_SIZE) != 0) {
+        RETURN_ERR("Failed to unmap huge allocation");
+    }
+    data->data = NULL;
+    data->capacity = 0;
+    pool_lock(pool, &pool->huge_lock);
+    pool->huge_freelist_data[pool->huge_freelist_count++] = data;
+    pool_unlock(pool, &pool->huge_lock);
+    pool_stats_free(pool, &pool->huge_stats);
+    return RESULT_OK;
+}
+
+static result_t pool_huge_resize(pool_t* pool, data_t* data, uint64_t capacity) {
+    capacity = pool_align(capacity, pool->page_size);
+    if (capacity == data->capacity) {
+        return RESULT_OK;
+    }
+    if (pool_canary_check(data->data + data->capacity) != RESULT_OK) {
+        RETURN_ERR("Refusing to resize corrupted huge data");
+    }
+    void* mem = mremap(data->data, data->capacity + POOL_CANARY_SIZE, capacity + POOL_CANARY_SIZE, MREMAP_MAYMOVE);
+    if (mem == MAP_FAILED) {
+        RETURN_ERR("Failed to remap huge allocation");
+    }
+    data->data = mem;
+    data->capacity = capacity;
+    if (data->size > capacity) {
+        data->size = capacity;
+    }
+    pool_canary_write(data->data + capacity);
+    return RESULT_OK;
+}
+
+// Arena pools hand out descriptors, payloads and objects from one bump
+// region. Frees only reclaim the most recent allocation; everything else
+// is released at once by pool_reset.
+static result_t pool_arena_take(pool_t* pool, uint64_t size, void** ptr) {
+    size = pool_align(size, 8);
+    if (size > pool->region_size - pool->arena_used) {
+        RETURN_ERR("Arena is exhausted");
+    }
+    if (pool->arena_used + size > pool->arena_committed) {
+        uint64_t committed = pool_align(pool->arena_used + size, POOL_SLAB_SIZE);
+        if (committed > pool->region_size) {
+            committed = pool->region_size;
+        }
+        if (pool_commit(pool, pool->region + pool->arena_committed, committed - pool->arena_committed) != RESULT_OK) {
+            RETURN_ERR("Failed to commit arena memory");
+        }
+        pool->arena_committed = committed;
+    }
+    *ptr = pool->region + pool->arena_used;
+    pool->arena_used += size;
+    return RESULT_OK;
+}
+
+static result_t pool_arena_data_alloc(pool_t* pool, data_t** data, uint64_t capacity) {
+    capacity = pool_align(capacity < 16 ? 16 : capacity, 8);
+    void* ptr = NULL;
+    if (pool_arena_take(pool, sizeof(data_t) + capacity, &ptr) != RESULT_OK) {
+        RETURN_ERR("Failed to take data from arena");
+    }
+    *data = ptr;
+    (*data)->data = (char*)ptr + sizeof(data_t);
+    (*data)->capacity = capacity;
+    (*data)->size = 0;
+    (*data)->hash = 0;
+    return RESULT_OK;
+}
+
+static uint64_t pool_arena_is_top(const pool_t* pool, const void* end) {
+    return (const char*)end == pool->region + pool->arena_used;
+}
+
+static result_t pool_arena_data_realloc(pool_t* pool, data_t** data, uint64_t capacity) {
+    data_t* old_data = *data;
+    if (capacity <= old_data->capacity) {
+        return RESULT_OK;
+    }
+    capacity = pool_align(capacity, 8);
+    if (pool_arena_is_top(pool, old_data->data + old_data->capacity)) {
+        void* ptr = NULL;
+        if (pool_arena_take(pool, capacity - old_data->capacity, &ptr) != RESULT_OK) {
+            RETURN_ERR("Failed to extend arena data in place");
+        }
+        old_data->capacity = capacity;
+        return RESULT_OK;
+    }
+    data_t* new_data = NULL;
+    if (pool_arena_data_alloc(pool, &new_data, capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to move arena data");
+    }
+    new_data->size = old_data->size;
+    memcpy(new_data->data, old_data->data, old_data->size);
+    *data = new_data;
+    return RESULT_OK;
+}
+
+// Interned data lives in an open-addressed table of data_t pointers that is
+// itself a pool allocation. Entries keep their hash, which also marks them
+// as shared and immutable: pool_data_free leaves them alone and
+// pool_data_realloc hands back a private copy. They are released together
+// by pool_destroy, or dropped with everything else by pool_reset.
+static result_t pool_intern_grow(pool_t* pool) {
+    uint64_t slots = pool->intern_slots != 0 ? pool->intern_slots * 2 : POOL_INTERN_MINCOUNT;
+    data_t* table = NULL;
+    if (pool_data_alloc(pool, &table, slots * sizeof(data_t*)) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate intern table");
+    }
+    data_t** entries = (data_t**)table->data;
+    memset(entries, 0, slots * sizeof(data_t*));
+    if (pool->intern_table != NULL) {
+        data_t** old_entries = (data_t**)pool->intern_table->data;
+        for (uint64_t i = 0; i < pool->intern_slots; i++) {
+            if (old_entries[i] == NULL) {
+                continue;
+            }
+            uint64_t j = old_entries[i]->hash & (slots - 1);
+            while (entries[j] != NULL) {
+                j = (j + 1) & (slots - 1);
+            }
+            entries[j] = old_entries[i];
+        }
+        if (pool_data_free(pool, pool->intern_table) != RESULT_OK) {
+            RETURN_ERR("Failed to free old intern table");
+        }
+    }
+    pool->intern_table = table;
+    pool->intern_slots = slots;
+    return RESULT_OK;
+}
+
+static result_t pool_intern_clear(pool_t* pool) {
+    if (pool->intern_table == NULL) {
+        return RESULT_OK;
+    }
+    data_t** entries = (data_t**)pool->intern_table->data;
+    for (uint64_t i = 0; i < pool->intern_slots; i++) {
+        if (entries[i] == NULL) {
+            continue;
+        }
+        entries[i]->hash = 0;
+        if (pool_data_free(pool, entries[i]) != RESULT_OK) {
+            RETURN_ERR("Failed to free interned data");
+        }
+    }
+    if (pool_data_free(pool, pool->intern_table) != RESULT_OK) {
+        RETURN_ERR("Failed to free intern table");
+    }
+    pool->intern_table = NULL;
+    pool->intern_slots = 0;
+    pool->intern_count = 0;
+    return RESULT_OK;
+}
+
+static uint64_t pool_log2_ceil(uint64_t value) {
+    if (value <= 1) {
+        return 0;
+    }
+    return 64 - (uint64_t)__builtin_clzll(value - 1);
+}
+
+// Smallest class that can hold capacity, or class_count when none can.
+static uint64_t pool_class_find(const pool_t* pool, uint64_t capacity) {
+    uint64_t index = pool->class_lookup[pool_log2_ceil(capacity)];
+    while (index < pool->class_count && pool->classes[index].capacity < capacity) {
+        index++;
+    }
+    return index;
+}
+
+result_t pool_config_default(pool_config_t* config) {
+    static const uint64_t capacities[] = {16, 256, 4096, 65536, 1048576};
+    static const uint64_t maxcounts[] = {
+        POOL_data16_MAXCOUNT,
+        POOL_data256_MAXCOUNT,
+        POOL_data4096_MAXCOUNT,
+        POOL_data65536_MAXCOUNT,
+        POOL_data1048576_MAXCOUNT,
+    };
+    config->class_count = COUNTOF(capacities);
+    for (uint64_t i = 0; i < COUNTOF(capacities); i++) {
+        config->class_capacity[i] = capacities[i];
+        config->class_maxcount[i] = maxcounts[i];
+    }
+    config->object_maxcount = POOL_OBJECT_MAXCOUNT;
+    config->huge_maxcount = POOL_HUGE_MAXCOUNT;
+    config->concurrent = 0;
+    config->intern = 0;
+    return RESULT_OK;
+}
+
+result_t pool_init(pool_t* pool, const pool_config_t* config) {
+    pool_config_t default_config;
+    if (config == NULL) {
+        if (pool_config_default(&default_config) != RESULT_OK) {
+            RETURN_ERR("Failed to build default pool config");
+        }
+        config = &default_config;
+    }
+    if (config->class_count == 0 || config->class_count > POOL_CLASS_MAXCOUNT) {
+        RETURN_ERR("Invalid number of size classes in pool config");
+    }
+    for (uint64_t i = 0; i < config->class_count; i++) {
+        if (config->class_capacity[i] == 0 || (i > 0 && config->class_capacity[i] <= config->class_capacity[i - 1])) {
+            RETURN_ERR("Size class capacities must be non-zero and strictly increasing");
+        }
+    }
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        RETURN_ERR("Failed to query page size");
+    }
+    pool->page_size = (uint64_t)page_size;
+    uint64_t offsets[POOL_CLASS_MAXCOUNT][4];
+    uint64_t size = 0;
+    for (uint64_t i = 0; i < config->class_count; i++) {
+        offsets[i][0] = size;
+        size = pool_align(size + config->class_maxcount[i] * sizeof(data_t), pool->page_size);
+        offsets[i][1] = size;
+        size = pool_align(size + config->class_maxcount[i] * sizeof(data_t*), pool->page_size);
+        offsets[i][2] = size;
+        size = pool_align(size + config->class_maxcount[i] * (config->class_capacity[i] + POOL_CANARY_SIZE), pool->page_size);
+        offsets[i][3] = size;
+        size = pool_align(size + config->class_maxcount[i] * pool_debug_size, pool->page_size);
+    }
+    uint64_t object_maxcount = pool_align(config->object_maxcount, POOL_OBJECT_CHUNK_SIZE);
+    uint64_t object_chunk_maxcount = object_maxcount / POOL_OBJECT_CHUNK_SIZE;
+    uint64_t object_offset = size;
+    size = pool_align(size + object_maxcount * sizeof(object_t), pool->page_size);
+    uint64_t object_freelist_offset = size;
+    size = pool_align(size + object_maxcount * sizeof(object_t*), pool->page_size);
+    uint64_t object_debug_offset = size;
+    size = pool_align(size + object_maxcount * pool_debug_size, pool->page_size);
+    uint64_t object_chunk_offset = size;
+    size = pool_align(size + object_chunk_maxcount * sizeof(uint64_t) * 2, pool->page_size);
+    uint64_t huge_offset = size;
+    size = pool_align(size + config->huge_maxcount * sizeof(data_t), pool->page_size);
+    uint64_t huge_freelist_offset = size;
+    size = pool_align(size + config->huge_maxcount * sizeof(data_t*), pool->page_size);
+    uint64_t huge_debug_offset = size;
+    size = pool_align(size + config->huge_maxcount * pool_debug_size, pool->page_size);
+    uint64_t cache_offset = size;
+    if (config->concurrent) {
+        size = pool_align(size + POOL_CACHE_MAXCOUNT * sizeof(pool_cache_t), pool->page_size);
+    }
+    void* region = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED) {
+        RETURN_ERR("Failed to reserve address space for pool");
+    }
+    pool->concurrent = config->concurrent;
+    pool->arena = 0;
+    pool->region = region;
+    pool->region_size = size;
+    pool->class_count = config->class_count;
+    for (uint64_t i = 0; i < config->class_count; i++) {
+        pool_class_t* cls = &pool->classes[i];
+        cls->capacity = config->class_capacity[i];
+        cls->maxcount = config->class_maxcount[i];
+        cls->count = 0;
+        cls->freelist_count = 0;
+        memset(&cls->stats, 0, sizeof(cls->stats));
+        cls->data = (data_t*)(pool->region + offsets[i][0]);
+        cls->freelist_data = (data_t**)(pool->region + offsets[i][1]);
+        cls->slot_data = pool->region + offsets[i][2];
+        cls->debug = pool_debug_size != 0 ? (pool_debug_t*)(pool->region + offsets[i][3]) : NULL;
+        pthread_mutex_init(&cls->lock, NULL);
+    }
+    for (uint64_t bits = 0, index = 0; bits < COUNTOF(pool->class_lookup); bits++) {
+        uint64_t floor = bits == 0 ? 0 : (uint64_t)1 << (bits - 1);
+        while (index < pool->class_count && pool->classes[index].capacity <= floor) {
+            index++;
+        }
+        pool->class_lookup[bits] = (uint8_t)index;
+    }
+    pool->object_maxcount = object_maxcount;
+    pool->object_data = (object_t*)(pool->region + object_offset);
+    pool->object_freelist_data = (object_t**)(pool->region + object_freelist_offset);
+    pool->object_debug = pool_debug_size != 0 ? (pool_debug_t*)(pool->region + object_debug_offset) : NULL;
+    pool->object_count = 0;
+    pool->object_freelist_count = 0;
+    pool->object_chunk_live = (uint64_t*)(pool->region + object_chunk_offset);
+    pool->object_chunk_freelist_data = pool->object_chunk_live + object_chunk_maxcount;
+    pool->object_chunk_freelist_count = 0;
+    pool->object_tail.next = NULL;
+    pool->object_tail.end = NULL;
+    memset(&pool->object_stats, 0, sizeof(pool->object_stats));
+    if (object_chunk_maxcount > 0 && pool_commit(pool, pool->object_chunk_live, object_chunk_maxcount * sizeof(uint64_t) * 2) != RESULT_OK) {
+        munmap(pool->region, pool->region_size);
+        pool->region = NULL;
+        RETURN_ERR("Failed to commit object chunk table");
+    }
+    pool->huge_maxcount = config->huge_maxcount;
+    pool->huge_data = (data_t*)(pool->region + huge_offset);
+    pool->huge_freelist_data = (data_t**)(pool->region + huge_freelist_offset);
+    pool->huge_debug = pool_debug_size != 0 ? (pool_debug_t*)(pool->region + huge_debug_offset) : NULL;
+    pool->huge_count = 0;
+    pool->huge_freelist_count = 0;
+    memset(&pool->huge_stats, 0, sizeof(pool->huge_stats));
+    pthread_mutex_init(&pool->object_lock, NULL);
+    pthread_mutex_init(&pool->huge_lock, NULL);
+    pthread_mutex_init(&pool->cache_lock, NULL);
+    pool->caches = (pool_cache_t*)(pool->region + cache_offset);
+    pool->cache_count = 0;
+    pthread_mutex_init(&pool->intern_lock, NULL);
+    pool->intern = config->intern;
+    pool->intern_table = NULL;
+    pool->intern_slots = 0;
+    pool->intern_count = 0;
+    if (pool->concurrent && pthread_key_create(&pool->cache_key, pool_cache_release) != 0) {
+        munmap(pool->region, pool->region_size);
+        pool->region = NULL;
+        RETURN_ERR("Failed to create thread cache key for pool");
+    }
+    return RESULT_OK;
+}
+
+result_t pool_arena_init(pool_t* pool, uint64_t size) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        RETURN_ERR("Failed to query page size");
+    }
+    pool->page_size = (uint64_t)page_size;
+    size = pool_align(size, pool->page_size);
+    void* region = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED) {
+        RETURN_ERR("Failed to reserve address space for arena");
+    }
+    pool->concurrent = 0;
+    pool->class_count = 0;
+    memset(pool->class_lookup, 0, sizeof(pool->class_lookup));
+    pool->arena = 1;
+    pool->arena_used = 0;
+    pool->arena_committed = 0;
+    memset(&pool->object_stats, 0, sizeof(pool->object_stats));
+    pool->intern = 0;
+    pool->intern_table = NULL;
+    pool->intern_slots = 0;
+    pool->intern_count = 0;
+    pool->region = region;
+    pool->region_size = size;
+    return RESULT_OK;
+}
+
+result_t pool_reset(pool_t* pool) {
+    if (!pool->arena) {
+        RETURN_ERR("Only arena pools can be reset");
+    }
+    pool->arena_used = 0;
+    pool->intern_table = NULL;
+    pool->intern_slots = 0;
+    pool->intern_count = 0;
+    return RESULT_OK;
+}
+
+result_t pool_destroy(pool_t* pool) {
+    if (pool->region == NULL) {
+        return RESULT_OK;
+    }
+    if (pool->arena) {
+        if (munmap(pool->region, pool->region_size) != 0) {
+            RETURN_ERR("Failed to release arena address space");
+        }
+        pool->region = NULL;
+        pool->region_size = 0;
+        return RESULT_OK;
+    }
+    if (pool_intern_clear(pool) != RESULT_OK) {
+        RETURN_ERR("Failed to release interned data");
+    }
+    pool_debug_report(pool);
+    for (uint64_t i = 0; i < pool->huge_count; i++) {
+        if (pool->huge_data[i].data != NULL && munmap(pool->huge_data[i].data, pool->huge_data[i].capacity + POOL_CANARY_SIZE) != 0) {
+            RETURN_ERR("Failed to unmap huge allocation");
+        }
+    }
+    for (uint64_t i = 0; i < pool->class_count; i++) {
+        pthread_mutex_destroy(&pool->classes[i].lock);
+    }
+    pthread_mutex_destroy(&pool->object_lock);
+    pthread_mutex_destroy(&pool->huge_lock);
+    if (pool->concurrent) {
+        pthread_key_delete(pool->cache_key);
+    }
+    pthread_mutex_destroy(&pool->cache_lock);
+    pthread_mutex_destroy(&pool->intern_lock);
+    if (munmap(pool->region, pool->region_size) != 0) {
+        RETURN_ERR("Failed to release pool address space");
+    }
+    pool->region = NULL;
+    pool->region_size = 0;
+    return RESULT_OK;
+}
+
+result_t pool_object_alloc(pool_t* pool, object_t** obj) {
+    pool_cache_t* cache = pool->concurrent ? pool_cache_get(pool) : NULL;
+    if (pool->arena) {
+        if (pool_arena_take(pool, sizeof(object_t), (void**)obj) != RESULT_OK) {
+            pool_stats_fail(pool, &pool->object_stats);
+            RETURN_ERR("No available object in arena");
+        }
+    } else if (cache == NULL) {
+        pool_lock(pool, &pool->object_lock);
+        result_t result = pool_object_pop(pool, obj);
+        pool_unlock(pool, &pool->object_lock);
+        if (result != RESULT_OK) {
+            pool_stats_fail(pool, &pool->object_stats);
+            RETURN_ERR("No available object in pool");
+        }
+    } else {
+        if (cache->object_count == 0) {
+            pthread_mutex_lock(&pool->object_lock);
+            while (cache->object_count < POOL_CACHE_SIZE / 2 &&
+                   (pool->object_freelist_count > 0 || pool->object_count < pool->object_maxcount) &&
+                   pool_object_pop(pool, &cache->object[cache->object_count]) == RESULT_OK) {
+                cache->object_count++;
+            }
+            pthread_mutex_unlock(&pool->object_lock);
+            if (cache->object_count == 0) {
+                pool_stats_fail(pool, &pool->object_stats);
+                RETURN_ERR("No available object in pool");
+            }
+        }
+        *obj = cache->object[--cache->object_count];
+    }
+    if (!pool->arena && pool_debug_take(pool->object_debug, pool->object_maxcount, (uint64_t)(*obj - pool->object_data), NULL) != RESULT_OK) {
+        RETURN_ERR("Failed to track object");
+    }
     (*obj)->data = NULL;
     (*obj)->child = NULL;
     (*obj)->next = NULL;
+    (*obj)->index = NULL;
+    pool_stats_alloc(pool, &pool->object_stats);
     return RESULT_OK;
 }
 
 result_t pool_object_free(pool_t* pool, object_t* obj) {
-    pool->object_freelist_data[pool->object_freelist_count++] = obj;
-    if (pool->object_freelist_count > POOL_OBJECT_MAXCOUNT) {
-        RETURN_ERR("Freelist overflow for object");
+    if (pool->arena) {
+        if (pool_arena_is_top(pool, obj + 1)) {
+            pool->arena_used = (uint64_t)((char*)obj - pool->region);
+        }
+        pool_stats_free(pool, &pool->object_stats);
+        return RESULT_OK;
     }
+    uint64_t index = (uint64_t)(obj - pool->object_data);
+    if (pool_debug_give(pool->object_debug, pool->object_maxcount, index, NULL) != RESULT_OK) {
+        RETURN_ERR("Refusing to free corrupted object");
+    }
+    if (index >= pool->object_maxcount) {
+        RETURN_ERR("Object does not belong to pool");
+    }
+    uint64_t chunk = index / POOL_OBJECT_CHUNK_SIZE;
+    if (__atomic_load_n(&pool->object_chunk_live[chunk], __ATOMIC_RELAXED) != POOL_OBJECT_CHUNK_SINGLE) {
+        pool_object_chunk_release(pool, chunk, 1);
+        pool_stats_free(pool, &pool->object_stats);
+        return RESULT_OK;
+    }
+    pool_cache_t* cache = pool->concurrent ? pool_cache_get(pool) : NULL;
+    if (cache == NULL) {
+        pool_lock(pool, &pool->object_lock);
+        result_t result = pool_object_push(pool, obj);
+        pool_unlock(pool, &pool->object_lock);
+        if (result != RESULT_OK) {
+            RETURN_ERR("Failed to return object to pool");
+        }
+        pool_stats_free(pool, &pool->object_stats);
+        return RESULT_OK;
+    }
+    if (cache->object_count == POOL_CACHE_SIZE) {
+        result_t result = RESULT_OK;
+        pthread_mutex_lock(&pool->object_lock);
+        while (result == RESULT_OK && cache->object_count > POOL_CACHE_SIZE / 2) {
+            result = pool_object_push(pool, cache->object[--cache->object_count]);
+        }
+        pthread_mutex_unlock(&pool->object_lock);
+        if (result != RESULT_OK) {
+            RETURN_ERR("Failed to spill thread cache for objects");
+        }
+    }
+    cache->object[cache->object_count++] = obj;
+    pool_stats_free(pool, &pool->object_stats);
+    return RESULT_OK;
+}
+
+result_t pool_object_slab_alloc(pool_t* pool, pool_object_slab_t* slab, object_t** obj) {
+    if (pool->arena) {
+        if (pool_object_alloc(pool, obj) != RESULT_OK) {
+            RETURN_ERR("No available object in arena");
+        }
+        return RESULT_OK;
+    }
+    if (slab->next == slab->end) {
+        pool_lock(pool, &pool->object_lock);
+        result_t result = pool_object_slab_refill(pool, slab);
+        pool_unlock(pool, &pool->object_lock);
+        if (result != RESULT_OK) {
+            pool_stats_fail(pool, &pool->object_stats);
+            RETURN_ERR("No available object slab in pool");
+        }
+    }
+    *obj = slab->next++;
+    if (pool_debug_take(pool->object_debug, pool->object_maxcount, (uint64_t)(*obj - pool->object_data), NULL) != RESULT_OK) {
+        RETURN_ERR("Failed to track object");
+    }
+    (*obj)->data = NULL;
+    (*obj)->child = NULL;
+    (*obj)->next = NULL;
+    (*obj)->index = NULL;
+    pool_stats_alloc(pool, &pool->object_stats);
+    return RESULT_OK;
+}
+
+result_t pool_object_slab_close(pool_t* pool, pool_object_slab_t* slab) {
+    if (!pool->arena && slab->next != slab->end) {
+        uint64_t chunk = (uint64_t)(slab->next - pool->object_data) / POOL_OBJECT_CHUNK_SIZE;
+        uint64_t unused = (uint64_t)(slab->end - slab->next);
+        pool_lock(pool, &pool->object_lock);
+        uint64_t keep = pool->object_tail.next == pool->object_tail.end;
+        if (keep) {
+            pool->object_tail = *slab;
+        }
+        pool_unlock(pool, &pool->object_lock);
+        if (!keep) {
+            pool_object_chunk_release(pool, chunk, unused);
+        }
+    }
+    slab->next = NULL;
+    slab->end = NULL;
     return RESULT_OK;
 }
 
 result_t pool_data16_alloc(pool_t* pool, data_t** data) {
-    if (pool->data16_freelist_count == 0) {
+    uint64_t index = pool_class_find(pool, 16);
+    if (index == pool->class_count || pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
         RETURN_ERR("No available data16 in pool");
     }
-    *data = pool->data16_freelist_data[--pool->data16_freelist_count];
     return RESULT_OK;
 }
 
 result_t pool_data256_alloc(pool_t* pool, data_t** data) {
-    if (pool->data256_freelist_count == 0) {
+    uint64_t index = pool_class_find(pool, 256);
+    if (index == pool->class_count || pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
         RETURN_ERR("No available data256 in pool");
     }
-    *data = pool->data256_freelist_data[--pool->data256_freelist_count];
     return RESULT_OK;
 }
 
 result_t pool_data4096_alloc(pool_t* pool, data_t** data) {
-    if (pool->data4096_freelist_count == 0) {
+    uint64_t index = pool_class_find(pool, 4096);
+    if (index == pool->class_count || pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
         RETURN_ERR("No available data4096 in pool");
     }
-    *data = pool->data4096_freelist_data[--pool->data4096_freelist_count];
     return RESULT_OK;
 }
 
 result_t pool_data65536_alloc(pool_t* pool, data_t** data) {
-    if (pool->data65536_freelist_count == 0) {
+    uint64_t index = pool_class_find(pool, 65536);
+    if (index == pool->class_count || pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
         RETURN_ERR("No available data65536 in pool");
     }
-    *data = pool->data65536_freelist_data[--pool->data65536_freelist_count];
     return RESULT_OK;
 }
 
 result_t pool_data1048576_alloc(pool_t* pool, data_t** data) {
-    if (pool->data1048576_freelist_count == 0) {
+    uint64_t index = pool_class_find(pool, 1048576);
+    if (index == pool->class_count || pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
         RETURN_ERR("No available data1048576 in pool");
     }
-    *data = pool->data1048576_freelist_data[--pool->data1048576_freelist_count];
     return RESULT_OK;
 }
 
@@ -89,68 +1089,206 @@ result_t pool_data_alloc(pool_t* pool, data_t** data, uint64_t capacity) {
     if (*data != NULL) {
         RETURN_ERR("Data pointer is not NULL");
     }
-    if (capacity <= 16) {
-        return pool_data16_alloc(pool, data);
-    } else if (capacity <= 256) {
-        return pool_data256_alloc(pool, data);
-    } else if (capacity <= 4096) {
-        return pool_data4096_alloc(pool, data);
-    } else if (capacity <= 65536) {
-        return pool_data65536_alloc(pool, data);
-    } else if (capacity <= 1048576) {
-        return pool_data1048576_alloc(pool, data);
-    } else {
-        RETURN_ERR("Invalid data size requested");
+    if (pool->arena) {
+        if (pool_arena_data_alloc(pool, data, capacity) != RESULT_OK) {
+            RETURN_ERR("Failed to allocate data from arena");
+        }
+        return RESULT_OK;
+    }
+    if (pool_is_huge(pool, capacity)) {
+        if (pool_huge_alloc(pool, data, capacity) != RESULT_OK) {
+            RETURN_ERR("Failed to allocate huge data");
+        }
+        return RESULT_OK;
+    }
+    uint64_t index = pool_class_find(pool, capacity);
+    if (pool_class_alloc(pool, &pool->classes[index], data) != RESULT_OK) {
+        RETURN_ERR("No available data in pool for requested size");
     }
+    return RESULT_OK;
 }
 
 result_t pool_data_free(pool_t* pool, data_t* data) {
     if (data == NULL) {
         RETURN_ERR("Cannot free null data");
     }
-    if (data->capacity == 16) {
-        pool->data16_freelist_data[pool->data16_freelist_count++] = data;
-        if (pool->data16_freelist_count > POOL_data16_MAXCOUNT) {
-            RETURN_ERR("Freelist overflow for data16");
+    if (data->hash != 0) {
+        return RESULT_OK;
+    }
+    if (pool->arena) {
+        if (pool_arena_is_top(pool, data->data + data->capacity) && data->data == (char*)(data + 1)) {
+            pool->arena_used = (uint64_t)((char*)data - pool->region);
         }
         return RESULT_OK;
-    } else if (data->capacity == 256) {
-        pool->data256_freelist_data[pool->data256_freelist_count++] = data;
-        if (pool->data256_freelist_count > POOL_data256_MAXCOUNT) {
-            RETURN_ERR("Freelist overflow for data256");
+    }
+    if (pool_is_huge(pool, data->capacity)) {
+        if (pool_huge_free(pool, data) != RESULT_OK) {
+            RETURN_ERR("Failed to free huge data");
         }
         return RESULT_OK;
-    } else if (data->capacity == 4096) {
-        pool->data4096_freelist_data[pool->data4096_freelist_count++] = data;
-        if (pool->data4096_freelist_count > POOL_data4096_MAXCOUNT) {
-            RETURN_ERR("Freelist overflow for data4096");
+    }
+    uint64_t index = pool_class_find(pool, data->capacity);
+    if (index == pool->class_count || pool->classes[index].capacity != data->capacity) {
+        RETURN_ERR("Invalid data capacity requested");
+    }
+    if (pool_class_free(pool, &pool->classes[index], data) != RESULT_OK) {
+        RETURN_ERR("Failed to free data");
+    }
+    return RESULT_OK;
+}
+
+static result_t pool_data_move(pool_t* pool, data_t** data, uint64_t capacity) {
+    data_t* old_data = *data;
+    data_t* new_data = NULL;
+    if (pool_data_alloc(pool, &new_data, capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to allocate data with sufficient capacity");
+    }
+    new_data->size = old_data->size < new_data->capacity ? old_data->size : new_data->capacity;
+    memcpy(new_data->data, old_data->data, new_data->size);
+    if (pool_data_free(pool, old_data) != RESULT_OK) {
+        if (pool_data_free(pool, new_data) != RESULT_OK) {
+            PRINT_ERR("Failed to free new data during cleanup");
+        }
+        RETURN_ERR("Failed to free existing data");
+    }
+    *data = new_data;
+    return RESULT_OK;
+}
+
+result_t pool_data_realloc(pool_t* pool, data_t** data, uint64_t capacity) {
+    data_t* old_data = *data;
+    if (old_data->hash != 0) {
+        // Interned data is shared, so growing it yields a private copy
+        if (pool_data_move(pool, data, capacity) != RESULT_OK) {
+            RETURN_ERR("Failed to copy interned data");
         }
         return RESULT_OK;
-    } else if (data->capacity == 65536) {
-        pool->data65536_freelist_data[pool->data65536_freelist_count++] = data;
-        if (pool->data65536_freelist_count > POOL_data65536_MAXCOUNT) {
-            RETURN_ERR("Freelist overflow for data65536");
+    }
+    if (pool->arena) {
+        if (pool_arena_data_realloc(pool, data, capacity) != RESULT_OK) {
+            RETURN_ERR("Failed to reallocate arena data");
         }
         return RESULT_OK;
-    } else if (data->capacity == 1048576) {
-        pool->data1048576_freelist_data[pool->data1048576_freelist_count++] = data;
-        if (pool->data1048576_freelist_count > POOL_data1048576_MAXCOUNT) {
-            RETURN_ERR("Freelist overflow for data1048576");
+    }
+    if (pool_is_huge(pool, old_data->capacity)) {
+        if (pool_is_huge(pool, capacity)) {
+            if (pool_huge_resize(pool, old_data, capacity) != RESULT_OK) {
+                RETURN_ERR("Failed to resize huge data");
+            }
+            return RESULT_OK;
         }
+    } else if (!pool_is_huge(pool, capacity) && pool_class_find(pool, capacity) == pool_class_find(pool, old_data->capacity)) {
         return RESULT_OK;
-    } else {
-        RETURN_ERR("Invalid data capacity requested");
     }
+    if (pool_data_move(pool, data, capacity) != RESULT_OK) {
+        RETURN_ERR("Failed to move data to a larger allocation");
+    }
+    return RESULT_OK;
 }
 
-result_t pool_data_realloc(pool_t* pool, data_t** data, uint64_t capacity) {
-    data_t* new_data = NULL;
-    if (pool_data_free(pool, *data) != RESULT_OK) {
-        RETURN_ERR("Failed to free existing data");
+result_t pool_intern(pool_t* pool, data_t** data, const data_view_t* view) {
+    if (*data != NULL) {
+        RETURN_ERR("Data pointer is not NULL");
     }
-    if (pool_data_alloc(pool, &new_data, capacity) != RESULT_OK) {
-        RETURN_ERR("Failed to allocate data with sufficient capacity");
+    uint64_t hash = data_view_hash(view);
+    pool_lock(pool, &pool->intern_lock);
+    if ((pool->intern_count + 1) * 4 > pool->intern_slots * 3 && pool_intern_grow(pool) != RESULT_OK) {
+        pool_unlock(pool, &pool->intern_lock);
+        RETURN_ERR("Failed to grow intern table");
+    }
+    data_t** entries = (data_t**)pool->intern_table->data;
+    uint64_t mask = pool->intern_slots - 1;
+    uint64_t i = hash & mask;
+    while (entries[i] != NULL) {
+        data_t* entry = entries[i];
+        if (entry->hash == hash && entry->size == view->size && memcmp(entry->data, view->data, view->size) == 0) {
+            pool_unlock(pool, &pool->intern_lock);
+            *data = entry;
+            return RESULT_OK;
+        }
+        i = (i + 1) & mask;
+    }
+    data_t* entry = NULL;
+    if (pool_data_alloc(pool, &entry, view->size) != RESULT_OK) {
+        pool_unlock(pool, &pool->intern_lock);
+        RETURN_ERR("Failed to allocate interned data");
+    }
+    memcpy(entry->data, view->data, view->size);
+    entry->size = view->size;
+    entry->hash = hash;
+    entries[i] = entry;
+    pool->intern_count++;
+    pool_unlock(pool, &pool->intern_lock);
+    *data = entry;
+    return RESULT_OK;
+}
+
+static result_t pool_stats_append_json(pool_t* pool, data_t** dst, const char* name, const pool_stats_t* stats) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s\"allocs\":%lu,\"frees\":%lu,\"used\":%lu,\"high_water\":%lu,\"failed\":%lu}", name, stats->allocs, stats->frees, stats->used, stats->high_water, stats->failed);
+    if (data_append_str(pool, dst, buf) != RESULT_OK) {
+        RETURN_ERR("Failed to append pool stats");
+    }
+    return RESULT_OK;
+}
+
+result_t pool_stats_todata_json(pool_t* pool, data_t** dst) {
+    // Snapshot first so the output buffer's own allocations are not counted.
+    pool_stats_t class_stats[POOL_CLASS_MAXCOUNT];
+    uint64_t class_counts[POOL_CLASS_MAXCOUNT];
+    pool_stats_t object_stats;
+    pool_stats_t huge_stats;
+    uint64_t arena_used = pool->arena_used;
+    for (uint64_t i = 0; i < pool->class_count; i++) {
+        pool_lock(pool, &pool->classes[i].lock);
+        class_counts[i] = pool->classes[i].count;
+        pool_unlock(pool, &pool->classes[i].lock);
+        pool_stats_snapshot(&pool->classes[i].stats, &class_stats[i]);
+    }
+    pool_stats_snapshot(&pool->object_stats, &object_stats);
+    pool_stats_snapshot(&pool->huge_stats, &huge_stats);
+    if (!*dst) {
+        if (data_create(pool, dst) != RESULT_OK) {
+            RETURN_ERR("Failed to create destination data buffer");
+        }
+    } else {
+        if (data_clean(pool, dst) != RESULT_OK) {
+            RETURN_ERR("Failed to clear destination data buffer");
+        }
+    }
+    char buf[256];
+    if (pool->arena) {
+        snprintf(buf, sizeof(buf), "{\"arena\":{\"size\":%lu,\"used\":%lu,\"committed\":%lu},", pool->region_size, arena_used, pool->arena_committed);
+        if (data_append_str(pool, dst, buf) != RESULT_OK) {
+            RETURN_ERR("Failed to append arena stats");
+        }
+        if (pool_stats_append_json(pool, dst, "\"objects\":{", &object_stats) != RESULT_OK) {
+            RETURN_ERR("Failed to append object stats");
+        }
+        if (data_append_char(pool, dst, '}') != RESULT_OK) {
+            RETURN_ERR("Failed to close pool stats");
+        }
+        return RESULT_OK;
+    }
+    if (data_append_str(pool, dst, "{\"classes\":[") != RESULT_OK) {
+        RETURN_ERR("Failed to append pool stats");
+    }
+    for (uint64_t i = 0; i < pool->class_count; i++) {
+        snprintf(buf, sizeof(buf), "%s{\"capacity\":%lu,\"maxcount\":%lu,\"committed\":%lu,", i == 0 ? "" : ",", pool->classes[i].capacity, pool->classes[i].maxcount, class_counts[i]);
+        if (pool_stats_append_json(pool, dst, buf, &class_stats[i]) != RESULT_OK) {
+            RETURN_ERR("Failed to append size class stats");
+        }
+    }
+    snprintf(buf, sizeof(buf), "],\"objects\":{\"maxcount\":%lu,", pool->object_maxcount);
+    if (pool_stats_append_json(pool, dst, buf, &object_stats) != RESULT_OK) {
+        RETURN_ERR("Failed to append object stats");
+    }
+    snprintf(buf, sizeof(buf), ",\"huge\":{\"maxcount\":%lu,", pool->huge_maxcount);
+    if (pool_stats_append_json(pool, dst, buf, &huge_stats) != RESULT_OK) {
+        RETURN_ERR("Failed to append huge stats");
+    }
+    if (data_append_char(pool, dst, '}') != RESULT_OK) {
+        RETURN_ERR("Failed to close pool stats");
     }
-    *data = new_data;
     return RESULT_OK;
 }